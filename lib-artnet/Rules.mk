@@ -78,6 +78,7 @@ else
 	EXTRA_INCLUDES+=../lib-tlc59711/include ../lib-tlc59711dmx/include
 	DEFINES+=ARTNET_HAVE_TIMECODE
 	DEFINES+=ARTNET_HAVE_FAILSAFE_RECORD
+	DEFINES+=DMXNODE_HAVE_CROSSFADE
 	DEFINES+=ARTNET_HAVE_DMXIN E131_HAVE_DMXIN
 	DEFINES+=OUTPUT_HAVE_STYLESWITCH
 	DEFINES+=OUTPUT_DMX_SEND
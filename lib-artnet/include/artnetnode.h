@@ -61,6 +61,9 @@
 #endif
 #include "dmxnode.h"
 #include "dmxnode_outputtype.h"
+#if defined(DMXNODE_HAVE_CROSSFADE) && (ARTNET_VERSION < 4)
+#include "dmxnodecrossfade.h"
+#endif
 #include "artnet_debug.h"
 #include "ip4/ip4_address.h"
 
@@ -261,6 +261,12 @@ inline void ArtNetNode::Run() {
     current_millis_ = timing::Millis();
     const auto kDeltaMillis = current_millis_ - packet_millis_;
 
+#if defined(DMXNODE_HAVE_CROSSFADE) && (ARTNET_VERSION < 4)
+    if (dmxnode::Crossfade::Get().IsRunning()) {
+        dmxnode::Crossfade::Get().Run(current_millis_);
+    }
+#endif
+
     if (kDeltaMillis >= artnet::kNetworkDataLossTimeout * 1000) {
         SetNetworkDataLossCondition();
     }
@@ -631,6 +631,7 @@ void ArtNetNode::SetNetworkDataLossCondition() {
         output_port_[i].source_a.ip = 0;
         output_port_[i].source_b.ip = 0;
         dmxnode::Data::ClearLength(i);
+        dmxnode::Data::ReleaseMergeSources(i);
     }
 
     board::statusled::SetMode(board::statusled::Mode::kNormal);
@@ -880,6 +881,7 @@ void ArtNetNode::CheckMergeTimeouts(uint32_t port_index) {
     if (kTimeOutAMillis > (artnet::kMergeTimeoutSeconds * 1000U)) {
         output_port_[port_index].source_a.ip = 0;
         output_port_[port_index].good_output &= static_cast<uint8_t>(~artnet::GoodOutput::kOutputIsMerging);
+        dmxnode::Data::ReleaseMergeSources(port_index);
     }
 
     const auto kTimeOutBMillis = current_millis_ - output_port_[port_index].source_b.millis;
@@ -887,6 +889,7 @@ void ArtNetNode::CheckMergeTimeouts(uint32_t port_index) {
     if (kTimeOutBMillis > (artnet::kMergeTimeoutSeconds * 1000U)) {
         output_port_[port_index].source_b.ip = 0;
         output_port_[port_index].good_output &= static_cast<uint8_t>(~artnet::GoodOutput::kOutputIsMerging);
+        dmxnode::Data::ReleaseMergeSources(port_index);
     }
 
     auto is_merging = false;
@@ -1034,7 +1037,11 @@ void ArtNetNode::HandleDmx() {
 
         if ((state_.is_synchronous_mode) && ((output_port_[port_index].good_output & artnet::GoodOutput::kOutputIsMerging) != artnet::GoodOutput::kOutputIsMerging)) {
             dmxnode::DataSet(dmxnode_output_type_, port_index);
-            output_port_[port_index].is_data_pending = true;
+
+            for (auto port_mask = dmxnode::OutputPortMask(1U << port_index); port_mask != 0; port_mask &= (port_mask - 1)) {
+                output_port_[__builtin_ctz(port_mask)].is_data_pending = true;
+            }
+
             SendDiag(artnet::PriorityCodes::kDiagLow, "%u: Buffering data", port_index);
         } else {
             dmxnode::DataOutput(dmxnode_output_type_, port_index);
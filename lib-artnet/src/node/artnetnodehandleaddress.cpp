@@ -148,6 +148,7 @@ void ArtNetNode::HandleAddress() {
                 output_port_[port_index].source_a.ip = 0;
                 output_port_[port_index].source_b.ip = 0;
                 output_port_[port_index].good_output &= static_cast<uint8_t>(~artnet::GoodOutput::kOutputIsMerging);
+                dmxnode::Data::ReleaseMergeSources(port_index);
             }
             break;
 
@@ -50,11 +50,14 @@ void ArtNetNode::FailSafeRecord() {
 void ArtNetNode::FailSafePlayback() {
     DEBUG_ENTRY();
 
+    uint8_t data[dmxnode::kUniverseSize];
+
     dmxnode::scenes::ReadStart();
 
     for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
         if (node_.port[port_index].direction == dmxnode::Direction::kOutput) {
-            dmxnode::scenes::Read(port_index, const_cast<uint8_t*>(dmxnode::Data::Backup(port_index)));
+            dmxnode::scenes::Read(port_index, data);
+            dmxnode::Data::Restore(port_index, data);
             dmxnode::DataOutput(dmxnode_output_type_, port_index);
 
             if (!output_port_[port_index].is_transmitting) {
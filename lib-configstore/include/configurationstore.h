@@ -65,6 +65,9 @@ inline constexpr size_t kGpsSize = 16;
 inline constexpr size_t kMidiSize = 16;
 inline constexpr size_t kRgbPanelSize = 16;
 inline constexpr size_t kWidgetSize = 16;
+inline constexpr size_t kDmxLedPortsSize = 64;
+inline constexpr size_t kDmxLedMatrixSize = 192;
+inline constexpr size_t kDmxNodePatchSize = 516;
 
 struct Global {
     int32_t utc_offset;
@@ -168,6 +171,28 @@ static_assert(offsetof(DmxNode, universe) % alignof(uint16_t) == 0, "universe mu
 static_assert(offsetof(DmxNode, protocol) % alignof(uint16_t) == 0, "protocol must be uint16_t-aligned");
 static_assert(sizeof(DmxNode) == kDmxNodeSize);
 
+namespace dmxnode::patch {
+inline constexpr uint32_t kMaxEntries = 64;
+} // namespace dmxnode::patch
+
+/**
+ * The entries of the patch matrix, 0-based offsets. An erased count (0xFF) is no patch.
+ */
+struct DmxNodePatch {
+    uint8_t count;
+    uint8_t reserved[3];
+    struct Entry {
+        uint16_t source_offset;
+        uint16_t destination_offset;
+        uint16_t count;
+        uint8_t source_port;
+        uint8_t destination_port;
+    } PACKED entry[dmxnode::patch::kMaxEntries];
+} PACKED;
+
+static_assert(offsetof(DmxNodePatch, entry) % alignof(uint16_t) == 0, "entry must be uint16_t-aligned");
+static_assert(sizeof(DmxNodePatch) == kDmxNodePatchSize);
+
 namespace osc::client {
 inline constexpr uint32_t kCmdCount = 8;
 inline constexpr uint32_t kCmdPathLength = 64;
@@ -241,6 +266,7 @@ inline constexpr uint32_t kMaxUniverses = 16;
 struct Flags {
     enum class Flag : uint32_t {
         kEnableGamma = (1U << 0),
+        kInput16Bit = (1U << 1),
     };
 
     static constexpr bool Has(uint32_t value, Flag flag) noexcept { return (value & static_cast<uint32_t>(flag)) != 0; }
@@ -254,7 +280,8 @@ struct DmxLed {
     uint16_t count;
     uint16_t grouping_count;
     uint16_t dmx_start_address;
-    uint8_t reserved1[4];
+    uint8_t frame_deadline_ms;
+    uint8_t reserved1[3];
     uint32_t spi_speed_hz;
     uint8_t global_brightness;
     uint8_t active_outputs;
@@ -262,15 +289,37 @@ struct DmxLed {
     uint8_t gamma_value;
     uint8_t low_code;
     uint8_t high_code;
-    uint8_t reserved2[6];
+    uint16_t interpolation; ///< The output ports that are interpolated, bit 0 is port 1
+    uint8_t reserved2[4];
     uint16_t start_universe[dmxled::kMaxUniverses];
 } PACKED;
 
 static_assert(offsetof(DmxLed, count) % alignof(uint16_t) == 0, "count must be uint16_t-aligned");
 static_assert(offsetof(DmxLed, spi_speed_hz) % alignof(uint32_t) == 0, "spi_speed_hz must be uint32_t-aligned");
+static_assert(offsetof(DmxLed, interpolation) % alignof(uint16_t) == 0, "interpolation must be uint16_t-aligned");
 static_assert(offsetof(DmxLed, start_universe) % alignof(uint16_t) == 0, "start_universe must be uint16_t-aligned");
 static_assert(sizeof(DmxLed) == kDmxLedSize);
 
+/**
+ * The multi-port pixel outputs, 0 is the setting of DmxLed
+ */
+struct DmxLedPorts {
+    uint16_t count[dmxled::kMaxUniverses];
+    uint8_t type[dmxled::kMaxUniverses]; ///< LedType + 1
+    uint8_t mirror[dmxled::kMaxUniverses]; ///< The number of the source port, 0 is none
+} PACKED;
+
+static_assert(sizeof(DmxLedPorts) == kDmxLedPortsSize);
+
+/**
+ * The colour matrix of the multi-port pixel outputs, all zero or erased (0xFF) is none
+ */
+struct DmxLedMatrix {
+    int8_t coefficient[dmxled::kMaxUniverses][12]; ///< Rows R, G, B, W and columns R, G, B in percent
+} PACKED;
+
+static_assert(sizeof(DmxLedMatrix) == kDmxLedMatrixSize);
+
 namespace dmxpwm {
 struct Flags {
     enum class Flag : uint32_t {
@@ -734,6 +783,9 @@ struct ConfigurationStore {
     common::store::Midi midi;
     common::store::RgbPanel rgb_panel;
     common::store::Widget widget;
+    common::store::DmxLedPorts dmx_led_ports; ///< Added last, the layout of a stored configuration is kept
+    common::store::DmxLedMatrix dmx_led_matrix;
+    common::store::DmxNodePatch dmx_node_patch;
 } PACKED;
 
 static_assert(offsetof(ConfigurationStore, global) == 16, "Wrong offset: global");
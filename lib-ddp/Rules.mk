@@ -5,3 +5,5 @@ else
 endif
 
 EXTRA_INCLUDES=../lib-dmx/include  ../lib-network/include ../lib-pixel/include ../lib-pixeldmx/include
+
+EXTRA_SRCDIR+=src/json
@@ -62,6 +62,11 @@ inline constexpr uint8_t STORAGE = 0x08;
 inline constexpr uint8_t TIME = 0x10;
 } // namespace flags1
 
+namespace flags2
+{
+inline constexpr uint8_t SEQ_MASK = 0x0f; ///< 1..15, 0 is not used
+} // namespace flags2
+
 namespace id
 {
 inline constexpr uint8_t DISPLAY = 1;
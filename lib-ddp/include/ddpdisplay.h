@@ -30,6 +30,8 @@
 #include <algorithm>
 
 #include "ddp.h"
+#include "ddpframe.h"
+#include "dmxnode.h"
 #include "dmxnode_outputtype.h"
 #include "ip4/ip4_address.h"
 #include "network_iface.h"
@@ -87,6 +89,7 @@ class DdpDisplay
         strip_data_length_ = count * channels_per_pixel;
         dmxnode_output_type_data_max_length_ = (channels_per_pixel == 4 ? 512U : 510U);
         active_ports_ = std::min(active_ports, ddpdisplay::configuration::pixel::kMaxPorts);
+        frame_.SetExpected(active_ports_ * strip_data_length_);
     }
 
     uint32_t GetCount() const { return count_; }
@@ -97,14 +100,43 @@ class DdpDisplay
 
     DmxNodeOutputType* GetOutput() const { return dmxnode_output_type_; }
 
+    /**
+     * The time after the first packet of a frame in which the others must arrive, 0 is the default.
+     */
+    void SetFrameDeadlineMillis(uint32_t frame_deadline_millis) { frame_.SetDeadlineMillis(frame_deadline_millis); }
+
+    /**
+     * The frame tracking, for the deadline and the counters
+     */
+    const auto& GetFrame() const { return frame_; }
+
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    /**
+     * The pixel ports are written straight into the pixel output, without universes.
+     * nullptr is no pixel output, for example when a test pattern is running.
+     */
+    void SetPixelOutput(DmxPixelOutputType* pixel_output) { pixel_output_ = pixel_output; }
+#endif
+
     void Input(const uint8_t* buffer, uint32_t size, uint32_t from_ip, uint16_t from_port);
 
+    /**
+     * Outputs the frame that is not complete at the deadline
+     */
+    void Run();
+
     static DdpDisplay* Get() { return s_this; }
 
    private:
     void CalculateOffsets();
     void HandleQuery();
     void HandleData();
+    bool ReceiveFrame(uint8_t flags2, uint32_t offset, uint32_t length);
+    void OutputFrame();
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    void SetPixels(uint32_t port_index, uint32_t port_offset, const uint8_t* data, uint32_t length);
+    void JoinPixel(uint32_t port_index, uint32_t pixel_offset, uint32_t index, const uint8_t* data, uint32_t length);
+#endif
 
     void static StaticCallbackFunction(const uint8_t* buffer, uint32_t size, uint32_t from_ip, uint16_t from_port)
     {
@@ -121,6 +153,23 @@ class DdpDisplay
     uint32_t active_ports_{0};
 
     DmxNodeOutputType* dmxnode_output_type_{nullptr};
+    ddp::Frame<ddpdisplay::lightset::kMaxPorts * dmxnode::kUniverseSize> frame_;
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    DmxPixelOutputType* pixel_output_{nullptr};
+    /**
+     * The pixels split over 2 packets, keyed by port and offset. The bytes
+     * that are in are set in mask.
+     */
+    struct SplitPixel {
+        uint8_t data[8];
+        uint32_t port;
+        uint32_t offset;
+        uint32_t mask;
+    };
+    static constexpr uint32_t kSplitPixels = 4;
+    SplitPixel split_[kSplitPixels];
+    uint32_t split_count_{0};
+#endif
 
     uint8_t mac_address_[network::iface::kMacSize];
 
@@ -0,0 +1,200 @@
+/**
+ * @file ddpframe.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DDPFRAME_H_
+#define DDPFRAME_H_
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace ddp {
+/**
+ * Tracks the packets of a frame. A frame is the sequence number of the header,
+ * the bytes of the pixel data received are kept in a bitmap. The frame is due
+ * when the PUSH is in and all bytes are covered, or when the deadline after
+ * the first packet has expired. Packets of an older frame, or of a frame that
+ * was output already, are stale. Sequence number 0 is not used by the sender,
+ * the frame then ends at its output.
+ *
+ * kMaxBytes is the capacity of the bitmap, a multiple of 32.
+ */
+template <uint32_t kMaxBytes> class Frame {
+   public:
+    static constexpr uint32_t kDeadlineMillisDefault = 25; ///< 40 Hz
+
+    /**
+     * The bytes from offset 0 that make a complete frame, clears the frame in progress
+     */
+    void SetExpected(uint32_t bytes) {
+        expected_ = std::min(bytes, kMaxBytes);
+        memset(covered_, 0, sizeof(covered_));
+        covered_bytes_ = 0;
+        is_push_ = false;
+        state_ = State::kIdle;
+    }
+
+    /**
+     * @param deadline_millis 0 is the default
+     */
+    void SetDeadlineMillis(uint32_t deadline_millis) { deadline_micros_ = 1000U * ((deadline_millis == 0) ? kDeadlineMillisDefault : deadline_millis); }
+
+    uint32_t GetDeadlineMillis() const { return deadline_micros_ / 1000U; }
+
+    /**
+     * The packet belongs to an older frame, or to a frame that was output already.
+     * After a second without frames any sequence number is accepted, the sender restarted.
+     */
+    bool IsStale(uint32_t sequence, uint32_t micros) {
+        if ((sequence == 0) || (sequence_ == 0) || (state_ == State::kIdle)) {
+            return false;
+        }
+
+        if ((state_ == State::kOutput) && ((micros - frame_micros_) >= kResyncMicros)) {
+            return false;
+        }
+
+        // 15 wraps to 1, the newer half of the window is ahead
+        const auto kDistance = (sequence + kSequenceNumbers - sequence_) % kSequenceNumbers;
+
+        if (((kDistance == 0) && (state_ == State::kOutput)) || (kDistance > (kSequenceNumbers / 2))) {
+            stale_packets_++;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * The packet starts the next frame while the current one is not complete,
+     * the current frame must be output first.
+     */
+    bool IsNext(uint32_t sequence) const { return (state_ == State::kOpen) && (sequence != sequence_); }
+
+    void Receive(uint32_t sequence, uint32_t micros) {
+        if (state_ != State::kOpen) {
+            state_ = State::kOpen;
+            sequence_ = sequence;
+            frame_micros_ = micros;
+        }
+    }
+
+    void Mark(uint32_t offset, uint32_t length) {
+        if (offset >= expected_) {
+            return;
+        }
+
+        const auto kEnd = std::min(offset + length, expected_);
+
+        while (offset < kEnd) {
+            const auto kWord = offset / 32U;
+            const auto kFirst = offset % 32U;
+            const auto kBits = std::min(32U - kFirst, kEnd - offset);
+            const auto kMask = ((kBits == 32U) ? ~0U : ((1U << kBits) - 1U)) << kFirst;
+
+            covered_bytes_ += static_cast<uint32_t>(__builtin_popcount(kMask & ~covered_[kWord]));
+            covered_[kWord] |= kMask;
+            offset += kBits;
+        }
+    }
+
+    void Push() { is_push_ = true; }
+
+    bool IsComplete() const { return (state_ == State::kOpen) && is_push_ && (covered_bytes_ == expected_); }
+
+    /**
+     * @return true when the deadline has expired, the frame must be output now
+     */
+    bool Poll(uint32_t micros) {
+        if ((state_ == State::kOpen) && ((micros - frame_micros_) >= deadline_micros_)) {
+            late_frames_++;
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * The frame has been sent to the output, the bytes not covered are counted
+     */
+    void Output() {
+        if (covered_bytes_ != expected_) {
+            incomplete_frames_++;
+            missing_segments_ += CountGaps();
+        }
+
+        memset(covered_, 0, sizeof(covered_));
+        covered_bytes_ = 0;
+        is_push_ = false;
+        state_ = State::kOutput;
+    }
+
+    uint32_t GetStalePackets() const { return stale_packets_; }
+    uint32_t GetLateFrames() const { return late_frames_; }             ///< Output at the deadline
+    uint32_t GetIncompleteFrames() const { return incomplete_frames_; } ///< Output with bytes not covered
+    uint32_t GetMissingSegments() const { return missing_segments_; }   ///< The ranges of bytes not covered
+
+   private:
+    /**
+     * A gap starts at a byte not covered that follows a covered byte, or offset 0
+     */
+    uint32_t CountGaps() const {
+        uint32_t gaps = 0;
+        uint32_t carry = 1; // The byte before offset 0 counts as covered
+
+        for (uint32_t word = 0; (word * 32U) < expected_; word++) {
+            const auto kBits = std::min(32U, expected_ - (word * 32U));
+            const auto kValid = (kBits == 32U) ? ~0U : ((1U << kBits) - 1U);
+            const auto kMissing = ~covered_[word] & kValid;
+            const auto kPreviousCovered = ~((kMissing << 1) | (carry ^ 1U));
+
+            gaps += static_cast<uint32_t>(__builtin_popcount(kMissing & kPreviousCovered));
+            carry = (covered_[word] >> 31) & 1U;
+        }
+
+        return gaps;
+    }
+
+    static_assert((kMaxBytes % 32U) == 0);
+    static constexpr uint32_t kSequenceNumbers = 15;
+    static constexpr uint32_t kResyncMicros = 1000000;
+
+    enum class State : uint8_t { kIdle, kOpen, kOutput };
+
+    uint32_t covered_[kMaxBytes / 32U]{};
+    uint32_t covered_bytes_{0};
+    uint32_t expected_{0};
+    uint32_t sequence_{0};
+    uint32_t frame_micros_{0};
+    uint32_t deadline_micros_{1000U * kDeadlineMillisDefault};
+    uint32_t stale_packets_{0};
+    uint32_t late_frames_{0};
+    uint32_t incomplete_frames_{0};
+    uint32_t missing_segments_{0};
+    bool is_push_{false};
+    State state_{State::kIdle};
+};
+} // namespace ddp
+
+#endif // DDPFRAME_H_
@@ -24,17 +24,23 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
 #include <cassert>
 
 #include "ddpdisplay.h"
 #include "ddp.h"
 #include "dmxnodedata.h"
 #include "dmxnode_data.h"
+#if defined(DMXNODE_HAVE_CROSSFADE)
+#include "dmxnodecrossfade.h"
+#endif
 #include "apps/mdns.h"
 #include "network_iface.h"
 #include "network_udp.h"
 #include "network_config.h"
 #include "board.h"
+#include "timing.h"
 #include "core/protocol/udp.h"
 #include "firmware/debug/debug_dump.h"
 #include "firmware/debug/debug_debug.h"
@@ -202,10 +208,157 @@ void DdpDisplay::HandleQuery() {
     DEBUG_EXIT();
 }
 
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+/**
+ * A fragment of a pixel that is split over 2 packets, the halves can come in
+ * any order. The pixel goes to the output when all its bytes are in.
+ */
+void DdpDisplay::JoinPixel(uint32_t port_index, uint32_t pixel_offset, uint32_t index, const uint8_t* data, uint32_t length) {
+    uint32_t i;
+
+    for (i = 0; i < split_count_; i++) {
+        if ((split_[i].port == port_index) && (split_[i].offset == pixel_offset)) {
+            break;
+        }
+    }
+
+    if (i == split_count_) {
+        if (split_count_ == kSplitPixels) {
+            // Drop the oldest
+            memmove(&split_[0], &split_[1], (kSplitPixels - 1) * sizeof(split_[0]));
+            split_count_--;
+        }
+
+        i = split_count_++;
+        split_[i].port = port_index;
+        split_[i].offset = pixel_offset;
+        split_[i].mask = 0;
+    }
+
+    auto& split = split_[i];
+
+    memcpy(&split.data[index], data, length);
+    split.mask |= ((1U << length) - 1) << index;
+
+    const auto kChannelsPerPixel = GetChannelsPerPixel();
+
+    if (split.mask == ((1U << kChannelsPerPixel) - 1)) {
+        pixel_output_->SetPixelData(port_index, pixel_offset, split.data, kChannelsPerPixel);
+        split = split_[--split_count_];
+    }
+}
+
+/**
+ * The whole pixels go to the output at once. The fragments at the start and
+ * the end of the packet are joined with the other half of their pixel.
+ */
+void DdpDisplay::SetPixels(uint32_t port_index, uint32_t port_offset, const uint8_t* data, uint32_t length) {
+    const auto kChannelsPerPixel = GetChannelsPerPixel();
+    const auto kHead = port_offset % kChannelsPerPixel;
+
+    if (kHead != 0) {
+        const auto kLength = std::min(length, kChannelsPerPixel - kHead);
+        JoinPixel(port_index, port_offset - kHead, kHead, data, kLength);
+        data += kLength;
+        port_offset += kLength;
+        length -= kLength;
+    }
+
+    const auto kTail = length % kChannelsPerPixel;
+    const auto kLength = length - kTail;
+
+    if (kLength != 0) {
+        pixel_output_->SetPixelData(port_index, port_offset, data, kLength);
+    }
+
+    if (kTail != 0) {
+        JoinPixel(port_index, port_offset + kLength, 0, &data[kLength], kTail);
+    }
+}
+
+/**
+ * The pixel data is converted into the pixel output as it arrives, the offset
+ * gives the port and the pixel. The frame is output when the PUSH is in and
+ * all pixel data is covered, else at the deadline.
+ */
+void DdpDisplay::HandleData() {
+    const auto* const kPacket = reinterpret_cast<ddp::Packet*>(receive_buffer_);
+    auto offset = static_cast<uint32_t>((kPacket->header.offset[0] << 24) | (kPacket->header.offset[1] << 16) | (kPacket->header.offset[2] << 8) | kPacket->header.offset[3]);
+    auto length = ((static_cast<uint32_t>(kPacket->header.len[0]) << 8) | kPacket->header.len[1]);
+
+    if (!ReceiveFrame(kPacket->header.flags2, offset, length)) {
+        return;
+    }
+    const auto* data = kPacket->data;
+
+    const auto kPixelDataEnd = s_offset_compare[ddpdisplay::configuration::pixel::kMaxPorts - 1];
+
+    while ((length != 0) && (offset < kPixelDataEnd)) {
+        const auto kPortIndex = offset / strip_data_length_;
+        const auto kPortOffset = offset - (kPortIndex * strip_data_length_);
+        const auto kLength = std::min(length, strip_data_length_ - kPortOffset);
+
+        if ((kPortIndex < active_ports_) && (pixel_output_ != nullptr)) {
+            SetPixels(kPortIndex, kPortOffset, data, kLength);
+        }
+
+        data += kLength;
+        offset += kLength;
+        length -= kLength;
+    }
+
+    /*
+     * 2x DMX ports, after the pixel ports
+     */
+
+    constexpr auto kDmxDataSourceIndex = ddpdisplay::lightset::kMaxPorts - ddpdisplay::configuration::dmx::kMaxPorts;
+
+    for (uint32_t port_index = ddpdisplay::configuration::pixel::kMaxPorts; (port_index < ddpdisplay::configuration::kMaxPorts) && (length != 0); port_index++) {
+        if (offset < s_offset_compare[port_index]) {
+            const auto kLength = std::min(length, s_offset_compare[port_index] - offset);
+            const auto kDataSourceIndex = kDmxDataSourceIndex + port_index - ddpdisplay::configuration::pixel::kMaxPorts;
+
+            dmxnode::Data::SetSourceA(kDataSourceIndex, data, kLength);
+            s_port_length[kDataSourceIndex] = kLength;
+
+            data += kLength;
+            offset += kLength;
+            length -= kLength;
+        }
+    }
+
+    if ((kPacket->header.flags1 & ddp::flags1::PUSH) == ddp::flags1::PUSH) {
+        frame_.Push();
+    }
+
+    if (frame_.IsComplete()) {
+        OutputFrame();
+    }
+}
+
+void DdpDisplay::OutputFrame() {
+    if (pixel_output_ != nullptr) {
+        pixel_output_->OutputPixelData();
+    }
+
+    split_count_ = 0;
+
+    for (auto data_output_port_index = ddpdisplay::lightset::kMaxPorts - ddpdisplay::configuration::dmx::kMaxPorts; data_output_port_index < ddpdisplay::lightset::kMaxPorts; data_output_port_index++) {
+        dmxnode::DataOutput(dmxnode_output_type_, data_output_port_index);
+        dmxnode::Data::ClearLength(data_output_port_index);
+    }
+
+    frame_.Output();
+}
+#else
 void DdpDisplay::HandleData() {
     const auto* const kPacket = reinterpret_cast<ddp::Packet*>(receive_buffer_);
     auto offset = static_cast<uint32_t>((kPacket->header.offset[0] << 24) | (kPacket->header.offset[1] << 16) | (kPacket->header.offset[2] << 8) | kPacket->header.offset[3]);
     auto length = ((static_cast<uint32_t>(kPacket->header.len[0]) << 8) | kPacket->header.len[1]);
+
+    if (!ReceiveFrame(kPacket->header.flags2, offset, length)) {
+        return;
+    }
     const auto* const kReceivedData = kPacket->data;
 
     uint32_t data_source_index = 0;
@@ -258,18 +411,67 @@ void DdpDisplay::HandleData() {
     }
 
     if ((kPacket->header.flags1 & ddp::flags1::PUSH) == ddp::flags1::PUSH) {
-        for (uint32_t data_output_port_index = 0; data_output_port_index < ddpdisplay::lightset::kMaxPorts; data_output_port_index++) {
-            dmxnode::DataOutput(dmxnode_output_type_, data_output_port_index);
-            dmxnode::Data::ClearLength(data_output_port_index);
-        }
+        frame_.Push();
     }
+
+    if (frame_.IsComplete()) {
+        OutputFrame();
+    }
+}
+
+void DdpDisplay::OutputFrame() {
+    for (uint32_t data_output_port_index = 0; data_output_port_index < ddpdisplay::lightset::kMaxPorts; data_output_port_index++) {
+        dmxnode::DataOutput(dmxnode_output_type_, data_output_port_index);
+        dmxnode::Data::ClearLength(data_output_port_index);
+    }
+
+    frame_.Output();
+}
+#endif
+
+/**
+ * A packet of a frame that was output already is dropped. A packet of the next
+ * frame outputs the current frame first, with the data it has.
+ */
+bool DdpDisplay::ReceiveFrame(uint8_t flags2, uint32_t offset, uint32_t length) {
+    const auto kSequence = static_cast<uint32_t>(flags2 & ddp::flags2::SEQ_MASK);
+    const auto kMicros = timing::Micros();
+
+    if (frame_.IsStale(kSequence, kMicros)) {
+        return false;
+    }
+
+    if (frame_.IsNext(kSequence)) {
+        OutputFrame();
+    }
+
+    frame_.Receive(kSequence, kMicros);
+    frame_.Mark(offset, length);
+
+    return true;
+}
+
+void DdpDisplay::Run() {
+    if (frame_.Poll(timing::Micros())) {
+        OutputFrame();
+    }
+
+#if defined(DMXNODE_HAVE_CROSSFADE)
+    if (dmxnode::Crossfade::Get().IsRunning()) {
+        dmxnode::Crossfade::Get().Run(timing::Millis());
+    }
+#endif
 }
 
-void DdpDisplay::Input(const uint8_t* buffer, uint32_t size, [[maybe_unused]] uint32_t from_ip, [[maybe_unused]] uint16_t from_port) {
+void DdpDisplay::Input(const uint8_t* buffer, uint32_t size, uint32_t from_ip, [[maybe_unused]] uint16_t from_port) {
     if (__builtin_expect((size < ddp::HEADER_LEN), 0)) {
         return;
     }
 
+    // The reply of a query is composed in the receive buffer
+    receive_buffer_ = const_cast<uint8_t*>(buffer);
+    from_ip_ = from_ip;
+
     if (from_ip_ == network::GetPrimaryIp()) {
         DEBUG_PUTS("Own message");
         return;
@@ -298,4 +500,9 @@ void DdpDisplay::Print() {
     printf(" Count             : %u\n", static_cast<unsigned>(count_));
     printf(" Channels per pixel: %u\n", static_cast<unsigned>(GetChannelsPerPixel()));
     printf(" Active ports      : %u\n", static_cast<unsigned>(active_ports_));
+    printf(" Frame deadline    : %u ms\n", static_cast<unsigned>(frame_.GetDeadlineMillis()));
+    printf(" Stale packets     : %u\n", static_cast<unsigned>(frame_.GetStalePackets()));
+    printf(" Late frames       : %u\n", static_cast<unsigned>(frame_.GetLateFrames()));
+    printf(" Incomplete frames : %u\n", static_cast<unsigned>(frame_.GetIncompleteFrames()));
+    printf(" Missing segments  : %u\n", static_cast<unsigned>(frame_.GetMissingSegments()));
 }
@@ -98,7 +98,7 @@ class DmxSend {
     void Sync(uint32_t port_index) {
         const auto kLightsetOffset = port_index + dmxnode::kDmxportOffset;
         assert(dmxnode::Data::GetLength(kLightsetOffset) != 0);
-        Dmx::Get()->SetTransmitDataWithoutSC<dmx::SendStyle::kSync>(port_index, dmxnode::Data::Backup(kLightsetOffset), dmxnode::Data::GetLength(kLightsetOffset));
+        Dmx::Get()->SetTransmitDataWithoutSC<dmx::SendStyle::kSync>(port_index, dmxnode::Data::Acquire(kLightsetOffset), dmxnode::Data::GetLength(kLightsetOffset));
     }
 
     void Sync() {
@@ -17,12 +17,18 @@ ifneq ($(MAKE_FLAGS),)
 	ifeq ($(findstring ARTNET_HAVE_FAILSAFE_RECORD,$(MAKE_FLAGS)), ARTNET_HAVE_FAILSAFE_RECORD)
 		EXTRA_SRCDIR+=src/scenes
 	endif
+	ifeq ($(findstring DMXNODE_HAVE_CROSSFADE,$(MAKE_FLAGS)), DMXNODE_HAVE_CROSSFADE)
+		EXTRA_SRCDIR+=src/crossfade
+	endif
 else
 	DEFINES+=NODE_ARTNET
 	DEFINES+=ARTNET_VERSION=4
 	DEFINES+=DMXNODE_PORTS=4
 	DEFINES+=OUTPUT_DMX_PIXEL
+	DEFINES+=DMXNODE_TRIPLE_BUFFER
+	DEFINES+=DMXNODE_HAVE_PATCH
+	DEFINES+=DMXNODE_HAVE_CROSSFADE
 	DEFINES+=CONFIG_DMXNODE_PIXEL_MAX_PORTS=4
-	EXTRA_SRCDIR+=src/json src/json/artnet src/json/e131
+	EXTRA_SRCDIR+=src/json src/json/artnet src/json/e131 src/crossfade
 	EXTRA_INCLUDES+=../lib-rdmsensor/include
 endif
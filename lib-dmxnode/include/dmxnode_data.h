@@ -30,16 +30,97 @@
 
 #include "dmxnode_outputtype.h"
 #include "dmxnodedata.h"
+#if defined(DMXNODE_HAVE_PATCH)
+#include "dmxnodepatch.h"
+#endif
+#if defined(DMXNODE_HAVE_CROSSFADE)
+#include "dmxnodecrossfade.h"
+#endif
 
 namespace dmxnode {
-inline void DataSet(DmxNodeOutputType* const kDmxNodeOutputType, uint32_t port_index) {
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+/**
+ * An output type opts in for the dirty slots with kHasDirtySlots and
+ * SetData<do_update>(port_index, data, length, const DirtySlots&)
+ */
+template <typename T>
+concept HasDirtySlots = requires { T::kHasDirtySlots; };
+
+static_assert(HasDirtySlots<DmxNodeOutputType>, "DMXNODE_HAVE_DIRTY_SLOTS is for output types with kHasDirtySlots only");
+#endif
+
+/**
+ * The output ports written for the data received on the ports of port_mask.
+ * With an active patch these are the destination ports, the nodes mark them pending for the synchronization.
+ */
+inline uint32_t OutputPortMask(uint32_t port_mask) {
+#if defined(DMXNODE_HAVE_PATCH)
+    const auto& kPatch = Patch::Get();
+
+    if (kPatch.IsActive()) {
+        uint32_t output_port_mask = 0;
+
+        for (; port_mask != 0; port_mask &= (port_mask - 1)) {
+            output_port_mask |= kPatch.GetDestinationMask(static_cast<uint32_t>(__builtin_ctz(port_mask)));
+        }
+
+        return output_port_mask;
+    }
+#endif
+    return port_mask;
+}
+
+#if defined(DMXNODE_HAVE_PATCH)
+template <bool do_update> inline void PatchOutput(DmxNodeOutputType* const kDmxNodeOutputType, uint32_t port_index, const uint8_t* data, uint32_t length) {
+    auto& patch = Patch::Get();
+
+    for (auto port_mask = patch.Apply(port_index, data, length); port_mask != 0; port_mask &= (port_mask - 1)) {
+        const auto kPortIndex = static_cast<uint32_t>(__builtin_ctz(port_mask));
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+        static constexpr DirtySlots kAllDirty{{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}};
+        kDmxNodeOutputType->template SetData<do_update>(kPortIndex, patch.GetData(kPortIndex), patch.GetLength(kPortIndex), kAllDirty);
+#else
+        kDmxNodeOutputType->template SetData<do_update>(kPortIndex, patch.GetData(kPortIndex), patch.GetLength(kPortIndex));
+#endif
+
+        if constexpr (do_update) {
+            // The node starts the port it received on only
+            if (patch.IsNotStarted(kPortIndex)) {
+                kDmxNodeOutputType->Start(kPortIndex);
+            }
+        }
+    }
+}
+#endif
+
+template <bool do_update> inline void DataOutputImpl(DmxNodeOutputType* const kDmxNodeOutputType, uint32_t port_index) {
     assert(kDmxNodeOutputType != nullptr);
-    kDmxNodeOutputType->SetData<false>(port_index, dmxnode::Data::Backup(port_index), dmxnode::Data::GetLength(port_index));
+    const auto* const kData = dmxnode::Data::Acquire(port_index);
+#if defined(DMXNODE_HAVE_PATCH)
+    if (Patch::Get().IsActive()) {
+        PatchOutput<do_update>(kDmxNodeOutputType, port_index, kData, dmxnode::Data::GetLength(port_index));
+        return;
+    }
+#endif
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+    kDmxNodeOutputType->template SetData<do_update>(port_index, kData, dmxnode::Data::GetLength(port_index), dmxnode::Data::GetDirty(port_index));
+#else
+    kDmxNodeOutputType->template SetData<do_update>(port_index, kData, dmxnode::Data::GetLength(port_index));
+#endif
+}
+
+inline void DataSet(DmxNodeOutputType* const kDmxNodeOutputType, uint32_t port_index) {
+#if defined(DMXNODE_HAVE_CROSSFADE)
+    Crossfade::Get().Cancel(port_index);
+#endif
+    DataOutputImpl<false>(kDmxNodeOutputType, port_index);
 }
 
 inline void DataOutput(DmxNodeOutputType* const kDmxNodeOutputType, uint32_t port_index) {
-    assert(kDmxNodeOutputType != nullptr);
-    kDmxNodeOutputType->SetData<true>(port_index, dmxnode::Data::Backup(port_index), dmxnode::Data::GetLength(port_index));
+#if defined(DMXNODE_HAVE_CROSSFADE)
+    Crossfade::Get().Cancel(port_index);
+#endif
+    DataOutputImpl<true>(kDmxNodeOutputType, port_index);
 }
 } // namespace dmxnode
 
@@ -0,0 +1,138 @@
+/**
+ * @file dmxnodecrossfade.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXNODECROSSFADE_H_
+#define DMXNODECROSSFADE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "dmxnode.h"
+#include "dmxnode_outputtype.h"
+
+namespace dmxnode {
+namespace crossfade {
+inline constexpr uint32_t kOne = 256; ///< The weight of the target at the end of the fade
+
+/**
+ * out = a + (b - a) * weight / 256 for 4 slots at once, the two 16-bit lanes
+ * of a product can not overflow as 255 * (256 - weight) + 255 * weight < 65536.
+ */
+inline constexpr uint32_t Blend(uint32_t a, uint32_t b, uint32_t weight) {
+    const auto kInverse = kOne - weight;
+    const auto kEven = (((a & 0x00FF00FF) * kInverse + (b & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;
+    const auto kOdd = (((a >> 8) & 0x00FF00FF) * kInverse + ((b >> 8) & 0x00FF00FF) * weight) & 0xFF00FF00;
+    return kEven | kOdd;
+}
+
+static_assert(Blend(0x00FF10FF, 0xFF00F0FF, 0) == 0x00FF10FF);
+static_assert(Blend(0x00FF10FF, 0xFF00F0FF, kOne) == 0xFF00F0FF);
+static_assert(Blend(0x00FF0000, 0xFF000080, 128) == 0x7F7F0040);
+} // namespace crossfade
+
+/**
+ * Crossfades all ports in parallel from a source to a target scene.
+ * The weight is fixed point, stepped from the elapsed time with a rate computed
+ * once at the start, so a frame costs no division.
+ *
+ * The crossfade is shared by the nodes, each node calls Run from its own Run.
+ * Live data has priority, dmxnode::DataSet and dmxnode::DataOutput cancel the port.
+ */
+class Crossfade {
+   public:
+#if defined(DMXNODE_CROSSFADE_INTERVAL_MILLIS)
+    static constexpr uint32_t kIntervalMillis = DMXNODE_CROSSFADE_INTERVAL_MILLIS;
+#else
+    static constexpr uint32_t kIntervalMillis = 23; ///< DMX refresh rate, 44 Hz
+#endif
+
+    static Crossfade& Get() {
+        static Crossfade instance;
+        return instance;
+    }
+
+    uint8_t* GetSource(uint32_t port_index) {
+        assert(port_index < dmxnode::kMaxPorts);
+        return reinterpret_cast<uint8_t*>(source_[port_index]);
+    }
+
+    uint8_t* GetTarget(uint32_t port_index) {
+        assert(port_index < dmxnode::kMaxPorts);
+        return reinterpret_cast<uint8_t*>(target_[port_index]);
+    }
+
+    /**
+     * GetSource and GetTarget must be filled for the ports in the port mask
+     */
+    void Start(DmxNodeOutputType* output_type, uint32_t port_mask, uint32_t duration_millis, uint32_t millis) {
+        assert(output_type != nullptr);
+        output_type_ = output_type;
+        port_mask_ = port_mask;
+        duration_millis_ = std::max(duration_millis, 1U);
+        // Q16 weight per millisecond, duration_millis_ * rate_ <= kOne << 16
+        rate_ = (crossfade::kOne << 16) / duration_millis_;
+        start_millis_ = millis;
+        last_millis_ = millis - kIntervalMillis;
+    }
+
+    /**
+     * Crossfades the output ports from what they output now to the recorded scene
+     */
+    void StartScene(uint32_t duration_millis);
+
+    /**
+     * Records what the output ports output now as the scene
+     */
+    void StoreScene();
+
+    void Stop() { port_mask_ = 0; }
+
+    /**
+     * The port has live data, it is no longer faded
+     */
+    void Cancel(uint32_t port_index) { port_mask_ &= ~(1U << port_index); }
+
+    bool IsRunning() const { return port_mask_ != 0; }
+
+    void Run(uint32_t millis);
+
+   private:
+    static constexpr auto kWords = dmxnode::kUniverseSize / 4;
+    static_assert(dmxnode::kMaxPorts <= 32, "The port mask is 32 bits");
+
+    uint32_t source_[dmxnode::kMaxPorts][kWords];
+    uint32_t target_[dmxnode::kMaxPorts][kWords];
+    uint32_t out_[kWords];
+    DmxNodeOutputType* output_type_{nullptr};
+    uint32_t port_mask_{0};
+    uint32_t duration_millis_{1};
+    uint32_t rate_{0};
+    uint32_t start_millis_{0};
+    uint32_t last_millis_{0};
+};
+} // namespace dmxnode
+
+#endif // DMXNODECROSSFADE_H_
@@ -46,7 +46,106 @@
 #define SECTION_LIGHTSET
 #endif
 
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+#define DMXNODE_HAVE_PRIORITY_MERGE
+#endif
+
+/*
+ * Only when the DmxNodeOutputType is an output that opts in with kHasDirtySlots,
+ * see dmxnode_outputtype.h. Else the compare would be done for nothing.
+ */
+#if (defined(OUTPUT_DMX_PCA9685) || defined(OUTPUT_DMX_TLC59711)) && !defined(OUTPUT_DMX_SEND) && !defined(OUTPUT_DMX_SEND_MULTI) && !defined(OUTPUT_DMX_ARTNET) && \
+    !defined(OUTPUT_DMX_MONITOR) && !defined(OUTPUT_DMX_PIXEL) && !defined(OUTPUT_DMX_PIXEL_MULTI) && !defined(OUTPUT_DMX_SERIAL) && !defined(OUTPUT_DMX_STEPPER)
+#define DMXNODE_HAVE_DIRTY_SLOTS
+#endif
+
 namespace dmxnode {
+#if defined(DMXNODE_HAVE_PRIORITY_MERGE) || defined(DMXNODE_HAVE_DIRTY_SLOTS)
+namespace merge {
+/**
+ * SWAR compare of 4 unsigned bytes at once.
+ * @return 0xFF in each byte where x >= y, 0x00 otherwise
+ */
+inline constexpr uint32_t GreaterEqual(uint32_t x, uint32_t y) {
+    constexpr uint32_t kHigh = 0x80808080;
+    // No borrow can cross a byte boundary: (x | 0x80) > (y & 0x7F)
+    const auto kLow = (x | kHigh) - (y & ~kHigh);
+    const auto kMsb = ((x & ~y) | (~(x ^ y) & kLow)) & kHigh;
+    return (kMsb >> 7) * 0xFFU;
+}
+
+/**
+ * Per slot HTP.
+ */
+inline constexpr uint32_t Max(uint32_t a, uint32_t b) {
+    const auto kMask = GreaterEqual(a, b);
+    return (a & kMask) | (b & ~kMask);
+}
+
+#if defined(DMXNODE_HAVE_PRIORITY_MERGE)
+/**
+ * Per slot: the highest priority wins, equal priorities are HTP merged.
+ * A slot with priority 0 from both sources is not sourced, it is 0.
+ */
+inline constexpr uint32_t Priority(uint32_t a, uint32_t b, uint32_t priority_a, uint32_t priority_b) {
+    const auto kAGreaterEqual = GreaterEqual(priority_a, priority_b);
+    const auto kBGreaterEqual = GreaterEqual(priority_b, priority_a);
+    const auto kEqual = kAGreaterEqual & kBGreaterEqual;
+    const auto kHtpMask = GreaterEqual(a, b);
+    const auto kHtp = (a & kHtpMask) | (b & ~kHtpMask);
+    const auto kSourced = ~GreaterEqual(0, priority_a | priority_b);
+
+    return ((a & kAGreaterEqual & ~kEqual) | (b & kBGreaterEqual & ~kEqual) | (kHtp & kEqual)) & kSourced;
+}
+
+static_assert(Priority(0x10203040, 0x40302010, 0x64646464, 0xC8016464) == 0x40203040);
+static_assert(Priority(0x10203040, 0x40302010, 0x00646464, 0x00016464) == 0x00203040);
+static_assert(Priority(0x10203040, 0x40302010, 0x00640000, 0x00000000) == 0x00200000);
+#endif
+
+static_assert(GreaterEqual(0x80057F00, 0x7F058000) == 0xFFFF00FF);
+static_assert(Max(0x80057F00, 0x7F058001) == 0x80058001);
+} // namespace merge
+#endif
+
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+/**
+ * Which slots changed since the output took the previous frame.
+ * Word granular: one bit per 4 slots.
+ */
+struct DirtySlots {
+    static constexpr uint32_t kWords = dmxnode::kUniverseSize / 4;
+
+    uint32_t bits[kWords / 32];
+
+    void SetAll() { memset(bits, 0xFF, sizeof(bits)); }
+    void Clear() { memset(bits, 0, sizeof(bits)); }
+    void Set(uint32_t word) { bits[word >> 5] |= (1U << (word & 31)); }
+
+    /**
+     * @param first_slot 0-based
+     * @return true when a slot in [first_slot, first_slot + count) might have changed
+     */
+    bool IsDirty(uint32_t first_slot, uint32_t count) const {
+        if (count == 0) {
+            return false;
+        }
+
+        const auto kLast = std::min((first_slot + count - 1) / 4, kWords - 1);
+
+        for (auto word = first_slot / 4; word <= kLast; word++) {
+            if ((bits[word >> 5] & (1U << (word & 31))) != 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+static_assert(sizeof(DirtySlots) == 16, "The initializer of OutputPort::dirty has 4 words");
+#endif
+
 class Data {
    public:
     static Data& Get() {
@@ -54,92 +153,418 @@ class Data {
         return instance;
     }
 
+#if defined(DMXNODE_MERGE_POOL)
+    static void SetSourceA(uint32_t port_index, const uint8_t* data, uint32_t length) { Get().ISet(port_index, data, length); }
+#else
     static void SetSourceA(uint32_t port_index, const uint8_t* data, uint32_t length) { Get().IMergeSourceA(port_index, data, length, MergeMode::kLtp); }
+#endif
 
     static void MergeSourceA(uint32_t port_index, const uint8_t* data, uint32_t length, MergeMode merge_mode) { Get().IMergeSourceA(port_index, data, length, merge_mode); }
 
+#if defined(DMXNODE_MERGE_POOL)
+    static void SetSourceB(uint32_t port_index, const uint8_t* data, uint32_t length) { Get().ISet(port_index, data, length); }
+#else
     static void SetSourceB(uint32_t port_index, const uint8_t* data, uint32_t length) { Get().IMergeSourceB(port_index, data, length, MergeMode::kLtp); }
+#endif
 
     static void MergeSourceB(uint32_t port_index, const uint8_t* data, uint32_t length, MergeMode merge_mode) { Get().IMergeSourceB(port_index, data, length, merge_mode); }
 
+#if defined(DMXNODE_HAVE_PRIORITY_MERGE)
+    static void PriorityMergeSourceA(uint32_t port_index, const uint8_t* data, uint32_t length, const uint8_t* priority_a, const uint8_t* priority_b) { Get().IPriorityMergeSourceA(port_index, data, length, priority_a, priority_b); }
+
+    static void PriorityMergeSourceB(uint32_t port_index, const uint8_t* data, uint32_t length, const uint8_t* priority_a, const uint8_t* priority_b) { Get().IPriorityMergeSourceB(port_index, data, length, priority_a, priority_b); }
+#endif
+
     static void Clear(uint32_t port_index) { Get().IClear(port_index); }
 
+    /**
+     * The port receives from a single source again, for example after the merge timeout
+     */
+#if defined(DMXNODE_MERGE_POOL)
+    static void ReleaseMergeSources(uint32_t port_index) { Get().IReleaseMergeSources(port_index); }
+#else
+    static void ReleaseMergeSources([[maybe_unused]] uint32_t port_index) {}
+#endif
+
     static void ClearLength(uint32_t port_index) { Get().IClearLength(port_index); }
 
     static uint32_t GetLength(uint32_t port_index) { return Get().IGetLength(port_index); }
 
+    /**
+     * @return The newest complete frame, read only
+     */
     static const uint8_t* Backup(uint32_t port_index) { return Get().IBackup(port_index); }
 
+    /**
+     * Called by the output side only. With DMXNODE_TRIPLE_BUFFER the returned frame
+     * is owned by the output until the next Acquire, receivers never write into it.
+     */
+    static const uint8_t* Acquire(uint32_t port_index) { return Get().IAcquire(port_index); }
+
+    /**
+     * Publishes a full universe written outside the receivers, for example a scene
+     */
     static void Restore(uint32_t port_index, const uint8_t* data) { Get().IRestore(port_index, data); }
 
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+    /**
+     * @return The slots changed in the frame returned by the last Acquire
+     */
+    static const DirtySlots& GetDirty(uint32_t port_index) { return Get().output_port_[port_index].acquired_dirty; }
+#endif
+
    private:
+    struct Frame {
+        uint8_t data[dmxnode::kUniverseSize] __attribute__((aligned(4)));
+        uint32_t length;
+    };
+
+#if defined(DMXNODE_TRIPLE_BUFFER)
+    /*
+     * Triple buffer: the receivers fill frame[write], a complete frame is published by
+     * exchanging the write and ready indexes. The output takes the newest frame by
+     * exchanging the ready and read indexes. No data is copied and a busy output
+     * never blocks a receiver, nor does a receiver ever write into the frame being output.
+     * All writers rewrite [0, length) completely, so the stale content of a recycled
+     * frame is never seen.
+     */
+    Frame& WriteFrame(uint32_t port_index) { return output_port_[port_index].frame[output_port_[port_index].write]; }
+
+    Frame& NewestFrame(uint32_t port_index) {
+        auto& output_port = output_port_[port_index];
+        return output_port.frame[output_port.is_fresh ? output_port.ready : output_port.read];
+    }
+
+    void Publish(uint32_t port_index) {
+        auto& output_port = output_port_[port_index];
+        const auto kIndex = output_port.write;
+        output_port.write = output_port.ready;
+        output_port.ready = kIndex;
+        output_port.is_fresh = true;
+    }
+#else
+    Frame& WriteFrame(uint32_t port_index) { return output_port_[port_index].frame; }
+    Frame& NewestFrame(uint32_t port_index) { return output_port_[port_index].frame; }
+    void Publish([[maybe_unused]] uint32_t port_index) {}
+#endif
+
+    struct Source {
+        uint8_t data[dmxnode::kUniverseSize] __attribute__((aligned(4)));
+    };
+
+    struct MergeSources {
+        Source source_a;
+        Source source_b;
+    };
+
+#if defined(DMXNODE_MERGE_POOL)
+    /*
+     * The merge sources are taken from the pool when a second source appears. Both are
+     * seeded with the newest frame, which holds the data of the single source so far.
+     * A port returns them when it receives from a single source again, at the merge
+     * timeout, or when it is cleared.
+     * @return nullptr when the pool is exhausted, the port then merges LTP
+     */
+    MergeSources* GetMergeSources(uint32_t port_index) {
+        auto& output_port = output_port_[port_index];
+
+        if (output_port.merge_index != kNoMergeSources) {
+            return &merge_pool_[output_port.merge_index];
+        }
+
+        if (merge_pool_free_ == 0) {
+            return nullptr;
+        }
+
+        const auto kIndex = static_cast<uint32_t>(__builtin_ctz(merge_pool_free_));
+        merge_pool_free_ &= ~(1U << kIndex);
+        output_port.merge_index = static_cast<uint8_t>(kIndex);
+
+        auto& merge_sources = merge_pool_[kIndex];
+        const auto& newest = NewestFrame(port_index);
+
+        // Not the length, it is cleared after the output
+        memcpy(merge_sources.source_a.data, newest.data, dmxnode::kUniverseSize);
+        memcpy(merge_sources.source_b.data, newest.data, dmxnode::kUniverseSize);
+
+        return &merge_sources;
+    }
+
+    void IReleaseMergeSources(uint32_t port_index) {
+        assert(port_index < kPorts);
+        auto& output_port = output_port_[port_index];
+
+        if (output_port.merge_index != kNoMergeSources) {
+            merge_pool_free_ |= (1U << output_port.merge_index);
+            output_port.merge_index = kNoMergeSources;
+        }
+    }
+
+    void ISet(uint32_t port_index, const uint8_t* data, uint32_t length) {
+        assert(port_index < kPorts);
+        assert(data != nullptr);
+
+        IReleaseMergeSources(port_index);
+        IMerge(port_index, nullptr, data, length, MergeMode::kLtp);
+    }
+#else
+    MergeSources* GetMergeSources(uint32_t port_index) { return &output_port_[port_index].merge_sources; }
+#endif
+
     void IMergeSourceA(uint32_t port_index, const uint8_t* data, uint32_t length, MergeMode merge_mode) {
         assert(port_index < kPorts);
         assert(data != nullptr);
+#if defined(DMXNODE_MERGE_POOL)
+        // LTP only needs the incoming data
+        auto* merge_sources = (merge_mode == MergeMode::kHtp) ? GetMergeSources(port_index) : nullptr;
+
+        if (merge_sources == nullptr) {
+            IMerge(port_index, nullptr, data, length, MergeMode::kLtp);
+            return;
+        }
+#else
+        auto* merge_sources = GetMergeSources(port_index);
+#endif
+        memcpy(merge_sources->source_a.data, data, length);
+
+        IMerge(port_index, merge_sources, merge_sources->source_a.data, length, merge_mode);
+    }
+
+    void IMergeSourceB(uint32_t port_index, const uint8_t* data, uint32_t length, MergeMode merge_mode) {
+        assert(port_index < kPorts);
+        assert(data != nullptr);
+#if defined(DMXNODE_MERGE_POOL)
+        auto* merge_sources = (merge_mode == MergeMode::kHtp) ? GetMergeSources(port_index) : nullptr;
+
+        if (merge_sources == nullptr) {
+            IMerge(port_index, nullptr, data, length, MergeMode::kLtp);
+            return;
+        }
+#else
+        auto* merge_sources = GetMergeSources(port_index);
+#endif
+        memcpy(merge_sources->source_b.data, data, length);
+
+        IMerge(port_index, merge_sources, merge_sources->source_b.data, length, merge_mode);
+    }
+
+    /**
+     * @param merge_sources Only used for HTP
+     */
+    void IMerge(uint32_t port_index, const MergeSources* merge_sources, const uint8_t* source, uint32_t length, MergeMode merge_mode) {
+        assert((merge_mode == MergeMode::kLtp) || (merge_sources != nullptr));
+        auto& frame = WriteFrame(port_index);
 
-        memcpy(output_port_[port_index].source_a.data, data, length);
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+        // The dirty bits are collected during the copy, compared against the newest frame
+        auto& output_port = output_port_[port_index];
+        const auto& previous = NewestFrame(port_index);
 
-        output_port_[port_index].length = length;
+        if (previous.length != length) {
+            output_port.dirty.SetAll();
+        }
 
+        const auto kIsHtp = (merge_mode == MergeMode::kHtp);
+        const auto* const kA = kIsHtp ? reinterpret_cast<const uint32_t*>(merge_sources->source_a.data) : nullptr;
+        const auto* const kB = kIsHtp ? reinterpret_cast<const uint32_t*>(merge_sources->source_b.data) : nullptr;
+        const auto* const kPrevious = reinterpret_cast<const uint32_t*>(previous.data);
+        auto* out = reinterpret_cast<uint32_t*>(frame.data);
+
+        const auto kWords = length / 4U;
+
+        for (uint32_t i = 0; i < kWords; i++) {
+            uint32_t value;
+
+            if (kIsHtp) {
+                value = merge::Max(kA[i], kB[i]);
+            } else {
+                memcpy(&value, &source[i * 4], sizeof(uint32_t)); // The source can be a packet buffer, not aligned
+            }
+
+            if (value != kPrevious[i]) {
+                output_port.dirty.Set(i);
+            }
+
+            out[i] = value;
+        }
+
+        // The source ends with the length, not with the word
+        for (auto i = kWords * 4U; i < length; i++) {
+            const auto kValue = kIsHtp ? std::max(merge_sources->source_a.data[i], merge_sources->source_b.data[i]) : source[i];
+
+            if (kValue != previous.data[i]) {
+                output_port.dirty.Set(i / 4U);
+            }
+
+            frame.data[i] = kValue;
+        }
+#else
         if (merge_mode == MergeMode::kHtp) {
             for (uint32_t i = 0; i < length; i++) {
-                const auto kData = std::max(output_port_[port_index].source_a.data[i], output_port_[port_index].source_b.data[i]);
-                output_port_[port_index].data[i] = kData;
+                const auto kData = std::max(merge_sources->source_a.data[i], merge_sources->source_b.data[i]);
+                frame.data[i] = kData;
             }
+        } else {
+            memcpy(frame.data, source, length);
+        }
+#endif
+
+        frame.length = length;
+
+        Publish(port_index);
+    }
+
+#if defined(DMXNODE_HAVE_PRIORITY_MERGE)
+    void IPriorityMergeSourceA(uint32_t port_index, const uint8_t* data, uint32_t length, const uint8_t* priority_a, const uint8_t* priority_b) {
+        assert(port_index < kPorts);
+        assert(data != nullptr);
 
+        auto* merge_sources = GetMergeSources(port_index);
+#if defined(DMXNODE_MERGE_POOL)
+        if (merge_sources == nullptr) {
+            IMerge(port_index, nullptr, data, length, MergeMode::kLtp);
             return;
         }
+#endif
+        memcpy(merge_sources->source_a.data, data, length);
 
-        memcpy(output_port_[port_index].data, data, length);
+        IPriorityMerge(port_index, merge_sources, length, priority_a, priority_b);
     }
 
-    void IMergeSourceB(uint32_t port_index, const uint8_t* data, uint32_t length, MergeMode merge_mode) {
+    void IPriorityMergeSourceB(uint32_t port_index, const uint8_t* data, uint32_t length, const uint8_t* priority_a, const uint8_t* priority_b) {
         assert(port_index < kPorts);
         assert(data != nullptr);
 
-        memcpy(output_port_[port_index].source_b.data, data, length);
+        auto* merge_sources = GetMergeSources(port_index);
+#if defined(DMXNODE_MERGE_POOL)
+        if (merge_sources == nullptr) {
+            IMerge(port_index, nullptr, data, length, MergeMode::kLtp);
+            return;
+        }
+#endif
+        memcpy(merge_sources->source_b.data, data, length);
 
-        output_port_[port_index].length = length;
+        IPriorityMerge(port_index, merge_sources, length, priority_a, priority_b);
+    }
 
-        if (merge_mode == MergeMode::kHtp) {
-            for (uint32_t i = 0; i < length; i++) {
-                const auto kData = std::max(output_port_[port_index].source_a.data[i], output_port_[port_index].source_b.data[i]);
-                output_port_[port_index].data[i] = kData;
+    /**
+     * The priority arrays must be 4-byte aligned and dmxnode::kUniverseSize long.
+     */
+    void IPriorityMerge(uint32_t port_index, const MergeSources* merge_sources, uint32_t length, const uint8_t* priority_a, const uint8_t* priority_b) {
+        assert(merge_sources != nullptr);
+        assert(priority_a != nullptr);
+        assert(priority_b != nullptr);
+
+        auto& frame = WriteFrame(port_index);
+
+        const auto* const kA = reinterpret_cast<const uint32_t*>(merge_sources->source_a.data);
+        const auto* const kB = reinterpret_cast<const uint32_t*>(merge_sources->source_b.data);
+        const auto* const kPriorityA = reinterpret_cast<const uint32_t*>(priority_a);
+        const auto* const kPriorityB = reinterpret_cast<const uint32_t*>(priority_b);
+        auto* out = reinterpret_cast<uint32_t*>(frame.data);
+
+        const auto kWords = (length + 3U) / 4U;
+
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+        auto& output_port = output_port_[port_index];
+        const auto& previous = NewestFrame(port_index);
+
+        if (previous.length != length) {
+            output_port.dirty.SetAll();
+        }
+
+        const auto* const kPrevious = reinterpret_cast<const uint32_t*>(previous.data);
+
+        for (uint32_t i = 0; i < kWords; i++) {
+            const auto kValue = merge::Priority(kA[i], kB[i], kPriorityA[i], kPriorityB[i]);
+
+            if (kValue != kPrevious[i]) {
+                output_port.dirty.Set(i);
             }
 
-            return;
+            out[i] = kValue;
+        }
+#else
+        for (uint32_t i = 0; i < kWords; i++) {
+            out[i] = merge::Priority(kA[i], kB[i], kPriorityA[i], kPriorityB[i]);
         }
+#endif
+
+        frame.length = length;
 
-        memcpy(output_port_[port_index].data, data, length);
+        Publish(port_index);
     }
+#endif
 
     void IClear(uint32_t port_index) {
         assert(port_index < kPorts);
+#if defined(DMXNODE_MERGE_POOL)
+        IReleaseMergeSources(port_index);
+#endif
+
+        auto& frame = WriteFrame(port_index);
+
+        memset(frame.data, 0, dmxnode::kUniverseSize);
+        frame.length = dmxnode::kUniverseSize;
 
-        memset(output_port_[port_index].data, 0, dmxnode::kUniverseSize);
-        output_port_[port_index].length = dmxnode::kUniverseSize;
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+        output_port_[port_index].dirty.SetAll();
+#endif
+
+        Publish(port_index);
     }
 
     void IClearLength(uint32_t port_index) {
         assert(port_index < kPorts);
-        output_port_[port_index].length = 0;
+        NewestFrame(port_index).length = 0;
     }
 
-    uint32_t IGetLength(uint32_t port_index) const {
+    uint32_t IGetLength(uint32_t port_index) {
         assert(port_index < kPorts);
-        return output_port_[port_index].length;
+        return NewestFrame(port_index).length;
     }
 
     const uint8_t* IBackup(uint32_t port_index) {
         assert(port_index < kPorts);
-        return const_cast<const uint8_t*>(output_port_[port_index].data);
+        return const_cast<const uint8_t*>(NewestFrame(port_index).data);
+    }
+
+    const uint8_t* IAcquire(uint32_t port_index) {
+        assert(port_index < kPorts);
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+        output_port_[port_index].acquired_dirty = output_port_[port_index].dirty;
+        output_port_[port_index].dirty.Clear();
+#endif
+#if defined(DMXNODE_TRIPLE_BUFFER)
+        auto& output_port = output_port_[port_index];
+
+        if (output_port.is_fresh) {
+            const auto kIndex = output_port.read;
+            output_port.read = output_port.ready;
+            output_port.ready = kIndex;
+            output_port.is_fresh = false;
+        }
+
+        return const_cast<const uint8_t*>(output_port.frame[output_port.read].data);
+#else
+        return const_cast<const uint8_t*>(output_port_[port_index].frame.data);
+#endif
     }
 
     void IRestore(uint32_t port_index, const uint8_t* data) {
         assert(port_index < kPorts);
         assert(data != nullptr);
 
-        memcpy(output_port_[port_index].data, data, dmxnode::kUniverseSize);
+        auto& frame = WriteFrame(port_index);
+
+        memcpy(frame.data, data, dmxnode::kUniverseSize);
+        frame.length = NewestFrame(port_index).length;
+
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+        output_port_[port_index].dirty.SetAll();
+#endif
+
+        Publish(port_index);
     }
 
 #if !defined(DMXNODE_PORTS)
@@ -152,18 +577,42 @@ class Data {
     static constexpr auto kPorts = DMXNODE_PORTS;
 #endif
 
-    struct Source {
-        uint8_t data[dmxnode::kUniverseSize] __attribute__((aligned(4)));
-    };
+#if defined(DMXNODE_MERGE_POOL)
+#if defined(DMXNODE_MERGE_POOL_SIZE)
+    static constexpr uint32_t kMergePoolSize = DMXNODE_MERGE_POOL_SIZE;
+#else
+    static constexpr uint32_t kMergePoolSize = 4;
+#endif
+    static_assert((kMergePoolSize > 0) && (kMergePoolSize <= 32), "merge_pool_free_ is a 32-bit mask");
+    static constexpr uint8_t kNoMergeSources = 0xFF;
+#endif
 
     struct OutputPort {
-        Source source_a;
-        Source source_b;
-        uint8_t data[dmxnode::kUniverseSize] __attribute__((aligned(4)));
-        uint32_t length;
+#if defined(DMXNODE_MERGE_POOL)
+        uint8_t merge_index{kNoMergeSources};
+#else
+        MergeSources merge_sources;
+#endif
+#if defined(DMXNODE_TRIPLE_BUFFER)
+        Frame frame[3];
+        uint8_t write{0};
+        uint8_t ready{1};
+        uint8_t read{2};
+        bool is_fresh{false}; ///< frame[ready] is newer than frame[read]
+#else
+        Frame frame;
+#endif
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+        DirtySlots dirty{{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}}; ///< Collected since the last Acquire
+        DirtySlots acquired_dirty;
+#endif
     };
 
     OutputPort output_port_[kPorts];
+#if defined(DMXNODE_MERGE_POOL)
+    MergeSources merge_pool_[kMergePoolSize];
+    uint32_t merge_pool_free_{static_cast<uint32_t>((1ULL << kMergePoolSize) - 1)};
+#endif
 };
 } // namespace dmxnode
 
@@ -0,0 +1,384 @@
+/**
+ * @file dmxnodepatch.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DMXNODEPATCH_H_
+#define DMXNODEPATCH_H_
+
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <cassert>
+
+#include "dmxnode.h"
+#include "dmxnodedata.h"
+
+namespace dmxnode {
+/**
+ * Patch matrix between the receivers and the output type.
+ *
+ * The source of an entry is the universe received on a port, after the merge.
+ * The destination is a port with direction output and a slot offset, entries
+ * to other ports are rejected. Once a patch is active the
+ * outputs are fully described by it: a port without entries is not updated,
+ * pass-through is the entry "a1-512>a1".
+ *
+ * The entries are compiled into memcpy runs, grouped per source port, with
+ * adjacent entries coalesced.
+ */
+class Patch {
+   public:
+#if defined(DMXNODE_PATCH_MAX_RUNS)
+    static constexpr uint32_t kMaxRuns = DMXNODE_PATCH_MAX_RUNS;
+#else
+    static constexpr uint32_t kMaxRuns = 64;
+#endif
+    static_assert(dmxnode::kMaxPorts <= 32, "The destination mask is 32 bits");
+
+    struct Entry {
+        uint16_t source_offset; ///< 0-based
+        uint16_t destination_offset; ///< 0-based
+        uint16_t count;
+        uint8_t source_port;
+        uint8_t destination_port;
+    };
+
+    static Patch& Get() {
+        static Patch instance;
+        return instance;
+    }
+
+    void Clear() {
+        entries_count_ = 0;
+        Compile();
+    }
+
+    /**
+     * The ports with direction output, set by the node configuration before the entries are added
+     */
+    void SetOutputPortMask(uint32_t port_mask) { output_port_mask_ = port_mask; }
+
+    /**
+     * @param source_slot 1-based
+     * @param destination_slot 1-based
+     */
+    bool Add(uint32_t source_port, uint32_t source_slot, uint32_t destination_port, uint32_t destination_slot, uint32_t count) {
+        if ((source_port >= dmxnode::kMaxPorts) || (destination_port >= dmxnode::kMaxPorts) || (count == 0)) {
+            return false;
+        }
+
+        if ((output_port_mask_ & (1U << destination_port)) == 0) {
+            return false;
+        }
+
+        if ((source_slot == 0) || (destination_slot == 0)) {
+            return false;
+        }
+
+        if (((source_slot - 1 + count) > dmxnode::kUniverseSize) || ((destination_slot - 1 + count) > dmxnode::kUniverseSize)) {
+            return false;
+        }
+
+        if (entries_count_ == kMaxRuns) {
+            return false;
+        }
+
+        auto& entry = entries_[entries_count_++];
+        entry.source_offset = static_cast<uint16_t>(source_slot - 1);
+        entry.destination_offset = static_cast<uint16_t>(destination_slot - 1);
+        entry.count = static_cast<uint16_t>(count);
+        entry.source_port = static_cast<uint8_t>(source_port);
+        entry.destination_port = static_cast<uint8_t>(destination_port);
+
+        return true;
+    }
+
+    /**
+     * Comma separated entries "<port><first>[-<last>]><port><first>", the ports are 'a', 'b', ..
+     * Example: "a1-512>a1,b1-256>a257"
+     * @return false when an entry is invalid, the patch is then empty
+     */
+    bool Parse(const char* text, uint32_t length) {
+        entries_count_ = 0;
+
+        const auto* p = text;
+        const auto* const kEnd = text + length;
+
+        while (p < kEnd) {
+            uint32_t source_port, source_first, source_last, destination_port, destination_first;
+
+            if (!ParsePortSlot(p, kEnd, source_port, source_first)) {
+                return Fail();
+            }
+
+            source_last = source_first;
+
+            if ((p < kEnd) && (*p == '-')) {
+                p++;
+                if (!ParseNumber(p, kEnd, source_last) || (source_last < source_first)) {
+                    return Fail();
+                }
+            }
+
+            SkipSpaces(p, kEnd);
+
+            if ((p == kEnd) || (*p++ != '>')) {
+                return Fail();
+            }
+
+            if (!ParsePortSlot(p, kEnd, destination_port, destination_first)) {
+                return Fail();
+            }
+
+            if (!Add(source_port, source_first, destination_port, destination_first, 1 + source_last - source_first)) {
+                return Fail();
+            }
+
+            SkipSpaces(p, kEnd);
+
+            if (p < kEnd) {
+                if (*p++ != ',') {
+                    return Fail();
+                }
+            }
+        }
+
+        Compile();
+        return true;
+    }
+
+    /**
+     * The inverse of Parse
+     */
+    uint32_t Serialize(char* buffer, uint32_t length) const {
+        uint32_t size = 0;
+
+        for (uint32_t i = 0; i < entries_count_; i++) {
+            const auto& entry = entries_[i];
+            const auto kSize = static_cast<uint32_t>(snprintf(&buffer[size], length - size, "%s%c%u-%u>%c%u", (i == 0) ? "" : ",",
+                                                              'a' + entry.source_port, 1U + entry.source_offset, static_cast<unsigned>(entry.source_offset + entry.count),
+                                                              'a' + entry.destination_port, 1U + entry.destination_offset));
+            if (kSize >= (length - size)) {
+                break;
+            }
+
+            size += kSize;
+        }
+
+        return size;
+    }
+
+    /**
+     * Builds the runs: a counting sort on the source port, sorted on the source offset
+     * within a port, and adjacent entries with the same destination port coalesced.
+     */
+    void Compile() {
+        uint32_t count[dmxnode::kMaxPorts] = {};
+
+        for (uint32_t i = 0; i < entries_count_; i++) {
+            count[entries_[i].source_port]++;
+        }
+
+        uint32_t first = 0;
+
+        for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+            run_first_[port_index] = static_cast<uint8_t>(first);
+            first += count[port_index];
+            count[port_index] = run_first_[port_index];
+        }
+
+        for (uint32_t i = 0; i < entries_count_; i++) {
+            runs_[count[entries_[i].source_port]++] = entries_[i];
+        }
+
+        runs_count_ = 0;
+
+        for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+            auto* const kBegin = &runs_[run_first_[port_index]];
+            auto* const kEnd = &runs_[count[port_index]];
+
+            // Insertion sort, stable: overlapping entries keep the order in which they were added
+            for (auto* i = kBegin; i < kEnd; i++) {
+                const auto kEntry = *i;
+                auto* j = i;
+
+                for (; (j > kBegin) && ((j - 1)->source_offset > kEntry.source_offset); j--) {
+                    *j = *(j - 1);
+                }
+
+                *j = kEntry;
+            }
+
+            run_first_[port_index] = static_cast<uint8_t>(runs_count_);
+            source_mask_[port_index] = 0;
+
+            for (auto* run = kBegin; run < kEnd; run++) {
+                if (runs_count_ != run_first_[port_index]) {
+                    auto& last = runs_[runs_count_ - 1];
+
+                    if ((last.destination_port == run->destination_port) && ((last.source_offset + last.count) == run->source_offset) &&
+                        ((last.destination_offset + last.count) == run->destination_offset)) {
+                        last.count = static_cast<uint16_t>(last.count + run->count);
+                        continue;
+                    }
+                }
+
+                runs_[runs_count_++] = *run;
+                source_mask_[port_index] |= (1U << run->destination_port);
+            }
+        }
+
+        run_first_[dmxnode::kMaxPorts] = static_cast<uint8_t>(runs_count_);
+        started_mask_ = 0;
+
+        for (auto& frame : frame_) {
+            memset(frame.data, 0, dmxnode::kUniverseSize);
+            frame.length = 0;
+        }
+    }
+
+    bool IsActive() const { return runs_count_ != 0; }
+
+    uint32_t GetEntriesCount() const { return entries_count_; }
+
+    const Entry& GetEntry(uint32_t index) const {
+        assert(index < entries_count_);
+        return entries_[index];
+    }
+
+    uint32_t GetRunsCount() const { return runs_count_; }
+
+    /**
+     * Copies the runs of the source port into the destination frames.
+     * @return The mask of destination ports that changed
+     */
+    uint32_t Apply(uint32_t source_port, const uint8_t* data, uint32_t length) {
+        assert(source_port < dmxnode::kMaxPorts);
+        assert(data != nullptr);
+
+        for (uint32_t i = run_first_[source_port]; i < run_first_[source_port + 1]; i++) {
+            const auto& run = runs_[i];
+
+            if (run.source_offset >= length) {
+                break; // The runs are sorted on the source offset
+            }
+
+            const auto kCount = std::min(static_cast<uint32_t>(run.count), length - run.source_offset);
+            auto& frame = frame_[run.destination_port];
+
+            memcpy(&frame.data[run.destination_offset], &data[run.source_offset], kCount);
+            frame.length = std::max(frame.length, run.destination_offset + kCount);
+        }
+
+        return source_mask_[source_port];
+    }
+
+    /**
+     * @return The mask of destination ports of the source port
+     */
+    uint32_t GetDestinationMask(uint32_t source_port) const { return source_mask_[source_port]; }
+
+    const uint8_t* GetData(uint32_t port_index) const { return frame_[port_index].data; }
+
+    uint32_t GetLength(uint32_t port_index) const { return frame_[port_index].length; }
+
+    /**
+     * @return true the first time after Compile, the node only starts the port it received on
+     */
+    bool IsNotStarted(uint32_t port_index) {
+        const auto kMask = (1U << port_index);
+
+        if ((started_mask_ & kMask) != 0) {
+            return false;
+        }
+
+        started_mask_ |= kMask;
+        return true;
+    }
+
+   private:
+    bool Fail() {
+        entries_count_ = 0;
+        Compile();
+        return false;
+    }
+
+    static void SkipSpaces(const char*& p, const char* end) {
+        while ((p < end) && (*p == ' ')) {
+            p++;
+        }
+    }
+
+    static bool ParseNumber(const char*& p, const char* end, uint32_t& value) {
+        SkipSpaces(p, end);
+
+        if ((p == end) || (*p < '0') || (*p > '9')) {
+            return false;
+        }
+
+        value = 0;
+
+        while ((p < end) && (*p >= '0') && (*p <= '9')) {
+            value = value * 10 + static_cast<uint32_t>(*p++ - '0');
+
+            if (value > dmxnode::kUniverseSize) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool ParsePortSlot(const char*& p, const char* end, uint32_t& port_index, uint32_t& slot) {
+        SkipSpaces(p, end);
+
+        if ((p == end) || (*p < 'a') || (*p > 'z')) {
+            return false;
+        }
+
+        port_index = static_cast<uint32_t>(*p++ - 'a');
+
+        return ParseNumber(p, end, slot);
+    }
+
+    struct Frame {
+        uint8_t data[dmxnode::kUniverseSize] __attribute__((aligned(4)));
+        uint32_t length;
+    };
+
+    Entry entries_[kMaxRuns];
+    Entry runs_[kMaxRuns];
+    Frame frame_[dmxnode::kMaxPorts];
+    uint32_t source_mask_[dmxnode::kMaxPorts]{};
+    uint32_t entries_count_{0};
+    uint32_t runs_count_{0};
+    uint32_t started_mask_{0};
+    uint32_t output_port_mask_{0};
+    uint8_t run_first_[dmxnode::kMaxPorts + 1]{};
+
+    static_assert(kMaxRuns <= UINT8_MAX);
+};
+} // namespace dmxnode
+
+#endif // DMXNODEPATCH_H_
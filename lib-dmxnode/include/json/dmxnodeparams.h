@@ -36,6 +36,9 @@
 #if defined(DMXNODE_OUTPUT_DMX)
 #include "dmx.h"
 #endif
+#if defined(DMXNODE_HAVE_PATCH)
+#include "dmxnode_nodetype.h"
+#endif
 
 namespace json {
 class DmxNodeParams : public JsonParamsBase<DmxNodeParams> {
@@ -51,6 +54,9 @@ class DmxNodeParams : public JsonParamsBase<DmxNodeParams> {
     void Load() { JsonParamsBase::Load(json::DmxNodeParamsConst::kFileName); }
     void Store(const char* buffer, uint32_t buffer_size);
     void Set();
+#if defined(DMXNODE_HAVE_PATCH)
+    static void StorePatch();
+#endif
 
    protected:
     void Dump();
@@ -59,6 +65,10 @@ class DmxNodeParams : public JsonParamsBase<DmxNodeParams> {
     static_assert(static_cast<uint32_t>(dmxnode::OutputStyle::kDelta) == 0);
     dmxnode::OutputStyle GetOutputStyleSet(uint8_t mask) const { return (store_dmxnode.output_style & mask) == mask ? dmxnode::OutputStyle::kConstant : dmxnode::OutputStyle::kDelta; }
 
+#if defined(DMXNODE_HAVE_PATCH)
+    static void SetPatch(const DmxNodeNodeType& dmx_node);
+#endif
+
     static void SetNodeName(const char* val, uint32_t len);
     static void SetFailsafe(const char* val, uint32_t len);
     static void SetDisableMergeTimeout(const char* val, uint32_t len);
@@ -41,6 +41,7 @@ struct DmxNodeParamsConst {
     static constexpr auto kDisableMergeTimeout = json::MakeSimpleKey("disable_merge_timeout");
     static constexpr auto kDmxStartAddress = json::MakeSimpleKey("dmx_start_address");
     static constexpr auto kDmxSlotInfo = json::MakeSimpleKey("dmx_slot_info");
+    static constexpr auto kPatch = json::MakeSimpleKey("patch");
 
 #if defined(DMX_MAX_PORTS)
     static constexpr json::PortKey kLabelPortA{"label_port_a", 12, Fnv1a32("label_port_a", 12)};
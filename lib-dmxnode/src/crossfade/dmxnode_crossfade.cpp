@@ -0,0 +1,131 @@
+/**
+ * @file dmxnode_crossfade.cpp
+ *
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "dmxnode.h"
+#include "dmxnodecrossfade.h"
+#include "dmxnodedata.h"
+#include "dmxnode_data.h"
+#include "dmxnode_nodetype.h"
+#include "timing.h"
+#include "firmware/debug/debug_debug.h"
+
+namespace dmxnode {
+/**
+ * The ports of a scene are the output ports of the node. The DDP Display has
+ * output ports only.
+ */
+static uint32_t ScenePortMask() {
+    uint32_t port_mask = 0;
+
+    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+#if defined(DMXNODE_TYPE_DDP)
+        if (port_index < ddpdisplay::lightset::kMaxPorts) {
+#else
+        if (DmxNodeNodeType::Get()->GetDirection(port_index) == dmxnode::Direction::kOutput) {
+#endif
+            port_mask |= (1U << port_index);
+        }
+    }
+
+    return port_mask;
+}
+
+void Crossfade::StartScene(uint32_t duration_millis) {
+    DEBUG_ENTRY();
+    DEBUG_PRINTF("duration_millis=%u", static_cast<unsigned>(duration_millis));
+
+    auto* output_type = DmxNodeNodeType::Get()->GetOutput();
+    assert(output_type != nullptr);
+
+    const auto kPortMask = ScenePortMask();
+
+    dmxnode::scenes::ReadStart();
+
+    for (auto port_mask = kPortMask; port_mask != 0; port_mask &= (port_mask - 1)) {
+        const auto kPortIndex = static_cast<uint32_t>(__builtin_ctz(port_mask));
+
+        memcpy(GetSource(kPortIndex), dmxnode::Data::Backup(kPortIndex), dmxnode::kUniverseSize);
+        dmxnode::scenes::Read(kPortIndex, GetTarget(kPortIndex));
+
+        // Start is idempotent, the node starts the port again on live data
+        output_type->Start(kPortIndex);
+    }
+
+    dmxnode::scenes::ReadEnd();
+
+    Start(output_type, kPortMask, duration_millis, timing::Millis());
+
+    DEBUG_EXIT();
+}
+
+void Crossfade::StoreScene() {
+    DEBUG_ENTRY();
+
+    dmxnode::scenes::WriteStart();
+
+    for (auto port_mask = ScenePortMask(); port_mask != 0; port_mask &= (port_mask - 1)) {
+        const auto kPortIndex = static_cast<uint32_t>(__builtin_ctz(port_mask));
+        dmxnode::scenes::Write(kPortIndex, dmxnode::Data::Backup(kPortIndex));
+    }
+
+    dmxnode::scenes::WriteEnd();
+
+    DEBUG_EXIT();
+}
+
+void Crossfade::Run(uint32_t millis) {
+    if ((millis - last_millis_) < kIntervalMillis) {
+        return;
+    }
+
+    last_millis_ = millis;
+
+    const auto kElapsed = std::min(millis - start_millis_, duration_millis_);
+    const auto kWeight = (kElapsed == duration_millis_) ? crossfade::kOne : std::min((kElapsed * rate_) >> 16, crossfade::kOne);
+
+    for (auto port_mask = port_mask_; port_mask != 0; port_mask &= (port_mask - 1)) {
+        const auto kPortIndex = static_cast<uint32_t>(__builtin_ctz(port_mask));
+        const auto* const kSource = source_[kPortIndex];
+        const auto* const kTarget = target_[kPortIndex];
+
+        for (uint32_t i = 0; i < kWords; i++) {
+            out_[i] = crossfade::Blend(kSource[i], kTarget[i], kWeight);
+        }
+
+        dmxnode::Data::SetSourceA(kPortIndex, reinterpret_cast<const uint8_t*>(out_), dmxnode::kUniverseSize);
+        // Not through DataOutput, that cancels the port
+        dmxnode::DataOutputImpl<true>(output_type_, kPortIndex);
+    }
+
+    if (kWeight == crossfade::kOne) {
+        port_mask_ = 0;
+    }
+}
+} // namespace dmxnode
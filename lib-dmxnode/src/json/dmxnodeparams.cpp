@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <cstring>
 #include <utility>
+#include <algorithm>
 
 #include "json/dmxnodeparams.h"
 #include "json/dmxnodeparamsconst.h"
@@ -41,6 +42,9 @@
 #if defined(DMXNODE_OUTPUT_DMX)
 #include "dmx.h"
 #endif
+#if defined(DMXNODE_HAVE_PATCH)
+#include "dmxnodepatch.h"
+#endif
 
 using common::store::dmxnode::Flags;
 
@@ -154,12 +158,69 @@ void DmxNodeParams::Set() {
         }
     }
 
+#if defined(DMXNODE_HAVE_PATCH)
+    SetPatch(*dmx_node);
+#endif
+
 #ifdef DEBUG_DMXNODE
     Dump();
 #endif
     DMXNODE_DEBUG_EXIT();
 }
 
+#if defined(DMXNODE_HAVE_PATCH)
+/**
+ * The stored entries are added again, an entry to a port that is no longer an output is dropped
+ */
+void DmxNodeParams::SetPatch(const DmxNodeNodeType& dmx_node) {
+    auto& patch = dmxnode::Patch::Get();
+    uint32_t output_port_mask = 0;
+
+    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+        if (dmx_node.GetDirection(port_index) == dmxnode::Direction::kOutput) {
+            output_port_mask |= (1U << port_index);
+        }
+    }
+
+    patch.SetOutputPortMask(output_port_mask);
+    patch.Clear();
+
+    common::store::DmxNodePatch store_patch;
+    ConfigStore::Instance().Copy(&store_patch, &ConfigurationStore::dmx_node_patch);
+
+    if (store_patch.count > common::store::dmxnode::patch::kMaxEntries) {
+        return; // Erased
+    }
+
+    for (uint32_t i = 0; i < store_patch.count; i++) {
+        const auto& kEntry = store_patch.entry[i];
+        patch.Add(kEntry.source_port, 1U + kEntry.source_offset, kEntry.destination_port, 1U + kEntry.destination_offset, kEntry.count);
+    }
+
+    patch.Compile();
+}
+
+void DmxNodeParams::StorePatch() {
+    const auto& kPatch = dmxnode::Patch::Get();
+    common::store::DmxNodePatch store_patch;
+
+    memset(&store_patch, 0, sizeof(store_patch));
+    store_patch.count = static_cast<uint8_t>(std::min(kPatch.GetEntriesCount(), common::store::dmxnode::patch::kMaxEntries));
+
+    for (uint32_t i = 0; i < store_patch.count; i++) {
+        const auto& kEntry = kPatch.GetEntry(i);
+        auto& entry = store_patch.entry[i];
+        entry.source_offset = kEntry.source_offset;
+        entry.destination_offset = kEntry.destination_offset;
+        entry.count = kEntry.count;
+        entry.source_port = kEntry.source_port;
+        entry.destination_port = kEntry.destination_port;
+    }
+
+    ConfigStore::Instance().Store(&store_patch, &ConfigurationStore::dmx_node_patch);
+}
+#endif
+
 void DmxNodeParams::Dump() {
     printf("%s::%s \'%s\':\n", __FILE__, __FUNCTION__, json::DmxNodeParamsConst::kFileName);
     printf(" %s=%s\n", json::DmxNodeParamsConst::kNodeName.name, store_dmxnode.node_name);
@@ -0,0 +1,66 @@
+/**
+ * @file json_action_scene.cpp
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#if defined(DMXNODE_HAVE_CROSSFADE)
+#include <cstdint>
+
+#include "json/json_key.h"
+#include "json/json_parser.h"
+#include "json/json_parsehelper.h"
+#include "dmxnodecrossfade.h"
+
+static constexpr uint32_t kMaxCrossfadeMillis = 60 * 1000;
+
+static void SetCrossfade(const char* val, uint32_t len) {
+    if (len > 5) return;
+
+    const auto kMillis = json::Atoi(val, len);
+
+    if ((kMillis < 0) || (static_cast<uint32_t>(kMillis) > kMaxCrossfadeMillis)) return;
+
+    dmxnode::Crossfade::Get().StartScene(static_cast<uint32_t>(kMillis));
+}
+
+static void SetStore(const char* val, uint32_t len) {
+    if (len != 1) return;
+
+    if (val[0] != '0') {
+        dmxnode::Crossfade::Get().StoreScene();
+    }
+}
+
+static constexpr auto kCrossfade = json::MakeSimpleKey("crossfade");
+static constexpr auto kStore = json::MakeSimpleKey("store");
+
+static constexpr json::Key kActionKeys[] = {
+	json::MakeKey(SetCrossfade, kCrossfade), 
+	json::MakeKey(SetStore, kStore)
+};
+
+namespace json::action {
+void SetScene(const char* buffer, uint32_t buffer_size) {
+    ParseJsonWithTable(buffer, buffer_size, kActionKeys);
+}
+} // namespace json::action
+#endif
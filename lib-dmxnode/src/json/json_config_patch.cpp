@@ -0,0 +1,65 @@
+/**
+ * @file json_config_patch.cpp
+ */
+/* Copyright (C) 2025-2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <cstdint>
+#include <cstdio>
+
+#if defined(DMXNODE_HAVE_PATCH)
+#include "dmxnodepatch.h"
+#include "json/dmxnodeparams.h"
+#include "json/dmxnodeparamsconst.h"
+#include "json/json_key.h"
+#include "json/json_parser.h"
+
+namespace json::config {
+static void SetPatch(const char* val, uint32_t len) {
+    dmxnode::Patch::Get().Parse(val, len);
+    ::json::DmxNodeParams::StorePatch();
+}
+
+/**
+ * {"patch":"a1-512>a1,b1-256>a257"}
+ */
+uint32_t GetDmxNodePatch(char* buffer, uint32_t length) {
+    const auto kPrefix = static_cast<uint32_t>(snprintf(buffer, length, "{\"%s\":\"", json::DmxNodeParamsConst::kPatch.name));
+
+    if ((kPrefix + 2) >= length) {
+        return 0;
+    }
+
+    auto size = kPrefix + dmxnode::Patch::Get().Serialize(&buffer[kPrefix], length - kPrefix - 2);
+
+    buffer[size++] = '"';
+    buffer[size++] = '}';
+
+    return size;
+}
+
+void SetDmxNodePatch(const char* buffer, uint32_t buffer_size) {
+    static constexpr json::Key kKeys[] = {MakeKey(SetPatch, json::DmxNodeParamsConst::kPatch)};
+    ParseJsonWithTable(buffer, buffer_size, kKeys);
+}
+} // namespace json::config
+#endif
@@ -45,6 +45,8 @@ void DmxNode::SceneStore() {
 }
 
 void DmxNode::ScenePlayback() {
+    uint8_t data[dmxnode::kUniverseSize];
+
     dmxnode::scenes::ReadStart();
 
     auto *dmxnode_output_type = DmxNodeNodeType::Get()->GetOutput();
@@ -54,7 +56,8 @@ void DmxNode::ScenePlayback() {
         auto& port = port_[port_index];
 
         if (port.port_direction == dmxnode::Direction::kOutput) {
-            dmxnode::scenes::Read(port_index, const_cast<uint8_t*>(dmxnode::Data::Backup(port_index)));
+            dmxnode::scenes::Read(port_index, data);
+            dmxnode::Data::Restore(port_index, data);
             dmxnode::DataOutput(dmxnode_output_type, port_index);
 
             if (!port.is_transmitting) {
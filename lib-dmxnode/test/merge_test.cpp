@@ -0,0 +1,202 @@
+/**
+ * @file merge_test.cpp
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/*
+ * Host test of the SWAR merge in dmxnodedata.h against the per slot loop,
+ * followed by a benchmark of both on a universe.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <random>
+
+#include "dmxnodedata.h"
+
+static_assert(dmxnode::kUniverseSize % 4 == 0);
+
+namespace scalar {
+static uint8_t Max(uint8_t a, uint8_t b) {
+    return (a >= b) ? a : b;
+}
+
+static uint8_t Priority(uint8_t a, uint8_t b, uint8_t priority_a, uint8_t priority_b) {
+    if ((priority_a == 0) && (priority_b == 0)) {
+        return 0;
+    }
+
+    if (priority_a > priority_b) {
+        return a;
+    }
+
+    if (priority_b > priority_a) {
+        return b;
+    }
+
+    return Max(a, b);
+}
+} // namespace scalar
+
+static uint8_t Slot(uint32_t word, uint32_t slot) {
+    return static_cast<uint8_t>(word >> (slot * 8));
+}
+
+static uint32_t s_errors;
+
+static void Check(bool is_ok, const char* name, uint32_t x, uint32_t y) {
+    if (!is_ok && (s_errors++ < 8)) {
+        printf("%s: 0x%08X 0x%08X\n", name, static_cast<unsigned>(x), static_cast<unsigned>(y));
+    }
+}
+
+/**
+ * All byte pairs in each lane, the other lanes random
+ */
+static void TestGreaterEqual(std::mt19937& random) {
+    for (uint32_t lane = 0; lane < 4; lane++) {
+        for (uint32_t x = 0; x < 256; x++) {
+            for (uint32_t y = 0; y < 256; y++) {
+                const auto kShift = lane * 8;
+                const auto kFill = ~(0xFFU << kShift);
+                const auto kX = (random() & kFill) | (x << kShift);
+                const auto kY = (random() & kFill) | (y << kShift);
+                const auto kResult = dmxnode::merge::GreaterEqual(kX, kY);
+
+                for (uint32_t slot = 0; slot < 4; slot++) {
+                    const auto kExpected = (Slot(kX, slot) >= Slot(kY, slot)) ? 0xFF : 0x00;
+                    Check(Slot(kResult, slot) == kExpected, "GreaterEqual", kX, kY);
+                }
+            }
+        }
+    }
+}
+
+static void TestMax(std::mt19937& random) {
+    for (uint32_t i = 0; i < (1U << 22); i++) {
+        const auto kA = static_cast<uint32_t>(random());
+        const auto kB = static_cast<uint32_t>(random());
+        const auto kResult = dmxnode::merge::Max(kA, kB);
+
+        for (uint32_t slot = 0; slot < 4; slot++) {
+            Check(Slot(kResult, slot) == scalar::Max(Slot(kA, slot), Slot(kB, slot)), "Max", kA, kB);
+        }
+    }
+}
+
+#if defined(DMXNODE_HAVE_PRIORITY_MERGE)
+/**
+ * The priorities are from a small set, so that equal and 0 priorities are common
+ */
+static void TestPriority(std::mt19937& random) {
+    static constexpr uint8_t kPriorities[] = {0, 1, 100, 100, 199, 200};
+
+    const auto kPriority = [&random]() {
+        uint32_t priority = 0;
+        for (uint32_t slot = 0; slot < 4; slot++) {
+            priority |= static_cast<uint32_t>(kPriorities[random() % sizeof(kPriorities)]) << (slot * 8);
+        }
+        return priority;
+    };
+
+    for (uint32_t i = 0; i < (1U << 22); i++) {
+        const auto kA = static_cast<uint32_t>(random());
+        const auto kB = static_cast<uint32_t>(random());
+        const auto kPriorityA = kPriority();
+        const auto kPriorityB = kPriority();
+        const auto kResult = dmxnode::merge::Priority(kA, kB, kPriorityA, kPriorityB);
+
+        for (uint32_t slot = 0; slot < 4; slot++) {
+            const auto kExpected = scalar::Priority(Slot(kA, slot), Slot(kB, slot), Slot(kPriorityA, slot), Slot(kPriorityB, slot));
+            Check(Slot(kResult, slot) == kExpected, "Priority", kA, kB);
+        }
+    }
+}
+#endif
+
+/**
+ * @return Mslots/s for the HTP merge of a universe
+ */
+template <typename F> static double Benchmark(F merge) {
+    static constexpr uint32_t kRuns = 100000;
+    const auto kStart = std::chrono::steady_clock::now();
+
+    for (uint32_t run = 0; run < kRuns; run++) {
+        merge();
+    }
+
+    const std::chrono::duration<double, std::micro> kElapsed = std::chrono::steady_clock::now() - kStart;
+    return (static_cast<double>(kRuns) * dmxnode::kUniverseSize) / kElapsed.count();
+}
+
+static void BenchmarkMax(std::mt19937& random) {
+    alignas(4) static uint8_t a[dmxnode::kUniverseSize];
+    alignas(4) static uint8_t b[dmxnode::kUniverseSize];
+    alignas(4) static uint8_t out[dmxnode::kUniverseSize];
+
+    for (uint32_t i = 0; i < dmxnode::kUniverseSize; i++) {
+        a[i] = static_cast<uint8_t>(random());
+        b[i] = static_cast<uint8_t>(random());
+    }
+
+    const auto kScalar = Benchmark([&]() {
+        for (uint32_t i = 0; i < dmxnode::kUniverseSize; i++) {
+            out[i] = scalar::Max(a[i], b[i]);
+        }
+        asm volatile("" : : "r"(out) : "memory");
+    });
+
+    const auto kSwar = Benchmark([&]() {
+        const auto* const kA = reinterpret_cast<const uint32_t*>(a);
+        const auto* const kB = reinterpret_cast<const uint32_t*>(b);
+        auto* const kOut = reinterpret_cast<uint32_t*>(out);
+        for (uint32_t i = 0; i < dmxnode::kUniverseSize / 4; i++) {
+            kOut[i] = dmxnode::merge::Max(kA[i], kB[i]);
+        }
+        asm volatile("" : : "r"(out) : "memory");
+    });
+
+    printf("HTP merge : scalar %.1f Mslots/s, SWAR %.1f Mslots/s\n", kScalar, kSwar);
+}
+
+int main() {
+    std::mt19937 random(0x5EED);
+
+    TestGreaterEqual(random);
+    TestMax(random);
+#if defined(DMXNODE_HAVE_PRIORITY_MERGE)
+    TestPriority(random);
+#endif
+
+    if (s_errors != 0) {
+        printf("FAILED: %u errors\n", static_cast<unsigned>(s_errors));
+        return 1;
+    }
+
+    puts("SWAR merge equals the per slot loop");
+
+    BenchmarkMax(random);
+
+    return 0;
+}
@@ -48,6 +48,8 @@ else
   EXTRA_SRCDIR+=src/node src/node/dmxin src/controller
   DEFINES+=NODE_E131
   DEFINES+=E131_HAVE_DMXIN
+  DEFINES+=E131_HAVE_PER_ADDRESS_PRIORITY
+  DEFINES+=E131_HAVE_DISCOVERY_TABLE
   DEFINES+=OUTPUT_HAVE_STYLESWITCH
   DEFINES+=OUTPUT_DMX_SEND
   DEFINES+=DMXNODE_PORTS=4
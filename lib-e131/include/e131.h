@@ -54,6 +54,11 @@ struct OptionsMask
     static constexpr bool Has(uint8_t value, Mask mask) noexcept { return (value & static_cast<uint8_t>(mask)) != 0; }
 };
 
+namespace startcode
+{
+inline constexpr uint8_t kDmx = 0x00;
+inline constexpr uint8_t kPerAddressPriority = 0xDD; ///< Per-address priority, as used by ETC and others
+} // namespace startcode
 namespace universe
 {
 inline constexpr auto kDefault = 1;
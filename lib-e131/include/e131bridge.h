@@ -30,7 +30,14 @@
 #include "dmxnode.h"
 #include "e131.h"
 #include "e131sync.h"
+#include "e131bridge_portmap.h"
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+#include "e131bridge_discoverytable.h"
+#endif
 #include "dmxnode_outputtype.h"
+#if defined(DMXNODE_HAVE_CROSSFADE)
+#include "dmxnodecrossfade.h"
+#endif
 #include "softwaretimers.h"
 #if defined(NODE_RDMNET_LLRP_ONLY)
 #include "llrp/llrpdevice.h"
@@ -48,7 +55,6 @@ enum StateFlags : uint8_t { kNetworkDataLoss = (1 << 0), kMergeMode = (1 << 1),
 struct State {
     uint8_t enabled_input_ports;
     uint8_t enabled_output_ports;
-    uint8_t priority;
     uint8_t receiving_dmx;
     dmxnode::FailSafe failsafe;
     e131bridge::Status status;
@@ -85,11 +91,27 @@ struct OutputPort {
     Source source_b ALIGNED;
     dmxnode::MergeMode merge_mode;
     dmxnode::OutputStyle output_style;
+    uint16_t synchronization_address; ///< From the last data packet, 0 is not synchronized
+    uint8_t priority; ///< Winning priority of the sources on this universe
     bool is_merging;
     bool is_transmitting;
     bool is_data_pending;
 };
 
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+struct PerAddressPriority {
+    uint8_t source_a[dmxnode::kUniverseSize] ALIGNED;
+    uint8_t source_b[dmxnode::kUniverseSize] ALIGNED;
+    uint32_t millis_a;
+    uint32_t millis_b;
+    uint8_t priority_a; ///< The universe priority of source A
+    uint8_t priority_b; ///< The universe priority of source B
+    bool has_source_a; ///< Source A is sending start code 0xDD packets
+    bool has_source_b; ///< Source B is sending start code 0xDD packets
+    bool is_active;
+};
+#endif
+
 struct InputPort {
     uint32_t multicast_ip;
     uint32_t millis;
@@ -182,6 +204,10 @@ class E131Bridge
     void HandleShowFile(const e131::DataPacket* pE131DataPacket);
 #endif
 
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+    const e131bridge::DiscoveryTable& GetDiscoveryTable() const { return discovery_table_; }
+#endif
+
     void Print();
 
     void Start();
@@ -200,15 +226,32 @@ class E131Bridge
     void SetSynchronizationAddress(bool source_a, bool source_b, uint16_t synchronization_address);
 
     void CheckMergeTimeouts(uint32_t port_index);
+    void CheckMergeMode();
+    void ClearSources(uint32_t port_index);
     bool IsPriorityTimeOut(uint32_t port_index) const;
     bool IsIpCidMatch(const e131bridge::Source* const kSource) const;
     void UpdateMergeStatus(uint32_t port_index);
 
     void HandleDmx();
+    void SetSourceA(uint32_t port_index, const uint8_t* data, uint32_t length);
+    void SetSourceB(uint32_t port_index, const uint8_t* data, uint32_t length);
+    void MergeSourceA(uint32_t port_index, const uint8_t* data, uint32_t length);
+    void MergeSourceB(uint32_t port_index, const uint8_t* data, uint32_t length);
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+    void SetPerAddressPriority(uint32_t port_index, bool is_source_a, bool is_source_b, const uint8_t* priority, uint32_t length);
+    void UpdatePerAddressPriority(uint32_t port_index, bool is_source_a, bool is_source_b, uint8_t priority);
+    void ReplacePerAddressSource(uint32_t port_index, uint8_t priority);
+#endif
     void HandleSynchronization();
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+    void HandleDiscovery(uint32_t size);
+#endif
 
     enum class JoinLeave { kJoin, kLeave };
 
+    void UpdateUniverseMap();
+    void UpdateSynchronizationMap();
+
     void JoinUniverse(uint32_t port_index, uint16_t universe);
     void LeaveUniverse(uint32_t port_index, uint16_t universe);
 
@@ -232,6 +275,14 @@ class E131Bridge
     e131bridge::Bridge bridge_;
     e131bridge::OutputPort output_port_[dmxnode::kMaxPorts];
     e131bridge::InputPort input_port_[dmxnode::kMaxPorts];
+    e131bridge::PortMap universe_map_;        ///< Output ports only
+    e131bridge::PortMap synchronization_map_; ///< Output ports only
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+    e131bridge::PerAddressPriority per_address_priority_[dmxnode::kMaxPorts];
+#endif
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+    e131bridge::DiscoveryTable discovery_table_;
+#endif
 
     bool enable_data_indicator_{true};
 
@@ -0,0 +1,263 @@
+/**
+ * @file e131bridge_discoverytable.h
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef E131BRIDGE_DISCOVERYTABLE_H_
+#define E131BRIDGE_DISCOVERYTABLE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <bit>
+
+#include "e131.h"
+#include "e117.h"
+
+namespace e131bridge {
+struct DiscoverySource {
+    uint8_t cid[e117::kCidLength];
+    char source_name[e131::kSourceNameLength];
+    uint32_t ip;
+    uint32_t millis;
+    uint32_t pages;          ///< Bitmask of the pages received in the current round
+    uint16_t universes;      ///< Number of universes listed in the pages received
+    uint16_t first_universe;
+    uint16_t last_universe;
+    uint8_t last_page;
+    bool is_used;
+};
+
+/**
+ * Sources announced with E1.31 Universe Discovery (Section 8), hashed on the CID.
+ * Open addressing with linear probing. The table is bounded to kMaxSources (at most
+ * half full), when it is full the expired sources are removed first, if there are none
+ * a new source is dropped.
+ */
+class DiscoveryTable {
+   public:
+    static constexpr uint32_t kMaxSources =
+#if defined(E131_DISCOVERY_MAX_SOURCES)
+        E131_DISCOVERY_MAX_SOURCES;
+#else
+        16;
+#endif
+    // 4.3 E131_UNIVERSE_DISCOVERY_INTERVAL is 10 seconds, allow for two missed rounds
+    static constexpr uint32_t kTimeoutMillis = 3U * e131::kUniverseDiscoveryIntervalSeconds * 1000U;
+    // 8.5 A page lists up to 512 universes
+    static constexpr uint32_t kUniversesPerPage = 512;
+
+    DiscoveryTable() { Clear(); }
+
+    void Clear() {
+        memset(entry_, 0, sizeof(entry_));
+        used_ = 0;
+    }
+
+    void Update(const e131::DiscoveryPacket& packet, uint32_t size, uint32_t ip, uint32_t millis) {
+        const auto kLayerLength = static_cast<uint32_t>(__builtin_bswap16(packet.universe_discovery_layer.flags_length) & 0x0FFF);
+        constexpr auto kLayerHeaderSize = e131::DiscoveryLayerLength(0);
+
+        if ((kLayerLength < kLayerHeaderSize) || (size < e131::DiscoveryPacketSize(0))) {
+            return;
+        }
+
+        auto universes = (kLayerLength - kLayerHeaderSize) / 2U;
+
+        // An invalid page
+        if (universes > kUniversesPerPage) {
+            return;
+        }
+
+        if (size < e131::DiscoveryPacketSize(universes)) {
+            universes = (size - e131::DiscoveryPacketSize(0)) / 2U;
+        }
+
+        auto* source = Insert(packet.root_layer.cid, millis);
+
+        if (source == nullptr) {
+            return;
+        }
+
+        const auto kPage = packet.universe_discovery_layer.page;
+
+        if ((kPage == 0) || (source->last_page != packet.universe_discovery_layer.last_page)) {
+            source->pages = 0;
+            source->universes = 0;
+            source->first_universe = 0xFFFF;
+            source->last_universe = 0;
+        }
+
+        source->ip = ip;
+        source->millis = millis;
+        source->last_page = packet.universe_discovery_layer.last_page;
+
+        memcpy(source->source_name, packet.frame_layer.source_name, e131::kSourceNameLength);
+        source->source_name[e131::kSourceNameLength - 1] = '\0';
+
+        const auto kPageBit = (kPage < 32) ? (1U << kPage) : 0;
+
+        if ((universes == 0) || ((source->pages & kPageBit) != 0)) {
+            return;
+        }
+
+        source->pages |= kPageBit;
+        source->universes = static_cast<uint16_t>(source->universes + universes);
+
+        // The list is sorted
+        const auto kFirst = __builtin_bswap16(packet.universe_discovery_layer.list_of_universes[0]);
+        const auto kLast = __builtin_bswap16(packet.universe_discovery_layer.list_of_universes[universes - 1]);
+
+        if (kFirst < source->first_universe) {
+            source->first_universe = kFirst;
+        }
+
+        if (kLast > source->last_universe) {
+            source->last_universe = kLast;
+        }
+    }
+
+    [[nodiscard]] const DiscoverySource* Find(const uint8_t* cid, uint32_t millis) const {
+        auto index = Hash(cid);
+
+        for (uint32_t i = 0; (i < kEntries) && entry_[index].is_used; i++) {
+            if (memcmp(entry_[index].cid, cid, e117::kCidLength) == 0) {
+                return IsExpired(entry_[index], millis) ? nullptr : &entry_[index];
+            }
+            index = (index + 1) & kMask;
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @return The active source at table index, nullptr when the entry is empty or expired.
+     */
+    [[nodiscard]] const DiscoverySource* Get(uint32_t index, uint32_t millis) const {
+        if ((index >= kEntries) || !entry_[index].is_used || IsExpired(entry_[index], millis)) {
+            return nullptr;
+        }
+
+        return &entry_[index];
+    }
+
+    [[nodiscard]] uint32_t Count(uint32_t millis) const {
+        uint32_t count = 0;
+
+        for (const auto& entry : entry_) {
+            count += (entry.is_used && !IsExpired(entry, millis)) ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    static constexpr uint32_t kEntries = std::bit_ceil(2U * kMaxSources);
+
+   private:
+    static constexpr uint32_t kMask = kEntries - 1;
+
+    // The CID is an UUID, the last bytes are the most random for both version 1 and 4
+    static uint32_t Hash(const uint8_t* cid) { return (static_cast<uint32_t>(cid[15]) ^ (static_cast<uint32_t>(cid[14]) << 8) ^ (static_cast<uint32_t>(cid[3]) << 4)) & kMask; }
+
+    static bool IsExpired(const DiscoverySource& entry, uint32_t millis) { return (millis - entry.millis) > kTimeoutMillis; }
+
+    DiscoverySource* Insert(const uint8_t* cid, uint32_t millis) {
+        auto index = Hash(cid);
+
+        while (entry_[index].is_used) {
+            if (memcmp(entry_[index].cid, cid, e117::kCidLength) == 0) {
+                return &entry_[index];
+            }
+            index = (index + 1) & kMask;
+        }
+
+        if (used_ == kMaxSources) {
+            RemoveExpired(millis);
+
+            if (used_ == kMaxSources) {
+                return nullptr;
+            }
+
+            // The probe sequence might have changed
+            index = Hash(cid);
+
+            while (entry_[index].is_used) {
+                index = (index + 1) & kMask;
+            }
+        }
+
+        used_++;
+
+        auto& entry = entry_[index];
+
+        memset(&entry, 0, sizeof(DiscoverySource));
+        memcpy(entry.cid, cid, e117::kCidLength);
+        entry.is_used = true;
+        entry.last_page = 0xFF; // Forces a reset of the page information
+
+        return &entry;
+    }
+
+    void RemoveExpired(uint32_t millis) {
+        uint32_t index = 0;
+
+        while (index < kEntries) {
+            if (entry_[index].is_used && IsExpired(entry_[index], millis)) {
+                Remove(index); // An entry might be shifted into index, so check it again
+            } else {
+                index++;
+            }
+        }
+    }
+
+    // Backward shift deletion, no tombstones needed
+    void Remove(uint32_t index) {
+        auto hole = index;
+        auto next = index;
+
+        for (;;) {
+            next = (next + 1) & kMask;
+
+            if (!entry_[next].is_used) {
+                break;
+            }
+
+            const auto kHome = Hash(entry_[next].cid);
+            // Stays when its home is cyclically in (hole, next]
+            const auto kStays = (hole <= next) ? ((hole < kHome) && (kHome <= next)) : ((hole < kHome) || (kHome <= next));
+
+            if (!kStays) {
+                entry_[hole] = entry_[next];
+                hole = next;
+            }
+        }
+
+        entry_[hole].is_used = false;
+        used_--;
+    }
+
+    DiscoverySource entry_[kEntries];
+    uint32_t used_{0};
+};
+} // namespace e131bridge
+
+#endif // E131BRIDGE_DISCOVERYTABLE_H_
@@ -113,15 +113,15 @@ inline dmxnode::Direction E131Bridge::PortDirection(uint32_t port_index) const {
 }
 
 inline bool E131Bridge::GetOutputPort(uint16_t universe, uint32_t& port_index) {
-    for (port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
-        if (bridge_.port[port_index].direction != dmxnode::Direction::kOutput) {
-            continue;
-        }
-        if (bridge_.port[port_index].universe == universe) {
-            return true;
-        }
+    const auto kPortMask = universe_map_.Find(universe);
+
+    if (kPortMask == 0) {
+        port_index = dmxnode::kMaxPorts;
+        return false;
     }
-    return false;
+
+    port_index = static_cast<uint32_t>(__builtin_ctz(kPortMask));
+    return true;
 }
 
 #if defined(OUTPUT_HAVE_STYLESWITCH)
@@ -254,6 +254,12 @@ inline void E131Bridge::Run() {
     current_millis_ = timing::Millis();
     const auto kDeltaMillis = current_millis_ - packet_millis_;
 
+#if defined(DMXNODE_HAVE_CROSSFADE)
+    if (dmxnode::Crossfade::Get().IsRunning()) {
+        dmxnode::Crossfade::Get().Run(current_millis_);
+    }
+#endif
+
     if (state_.enabled_output_ports != 0) {
         if (kDeltaMillis >= static_cast<uint32_t>(e131::kNetworkDataLossTimeoutSeconds * 1000)) {
             if ((dmxnode_output_type_ != nullptr) && (!state_.is_network_data_loss)) {
@@ -0,0 +1,94 @@
+/**
+ * @file e131bridge_portmap.h
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef E131BRIDGE_PORTMAP_H_
+#define E131BRIDGE_PORTMAP_H_
+
+#include <cstdint>
+#include <cstring>
+#include <bit>
+
+#include "dmxnode.h"
+
+namespace e131bridge {
+static_assert(dmxnode::kMaxPorts <= 32, "The port mask is an uint32_t");
+
+/**
+ * Maps a universe number (or synchronization address) to a bitmask of port indexes.
+ * Open addressing with linear probing, the key 0 marks an empty entry.
+ * It is rebuilt with Clear()/Add() when the configuration changes.
+ */
+class PortMap {
+   public:
+    PortMap() { Clear(); }
+
+    void Clear() { memset(entry_, 0, sizeof(entry_)); }
+
+    void Add(uint16_t key, uint32_t port_index) {
+        if (key == 0) {
+            return;
+        }
+
+        auto index = Hash(key);
+
+        while ((entry_[index].key != 0) && (entry_[index].key != key)) {
+            index = (index + 1) & kMask;
+        }
+
+        entry_[index].key = key;
+        entry_[index].port_mask |= (1U << port_index);
+    }
+
+    [[nodiscard]] uint32_t Find(uint16_t key) const {
+        auto index = Hash(key);
+
+        while (entry_[index].key != 0) {
+            if (entry_[index].key == key) {
+                return entry_[index].port_mask;
+            }
+            index = (index + 1) & kMask;
+        }
+
+        return 0;
+    }
+
+   private:
+    // At most half full, so a lookup for a missing key ends quickly
+    static constexpr uint32_t kEntries = std::bit_ceil(2U * dmxnode::kMaxPorts);
+    static constexpr uint32_t kMask = kEntries - 1;
+
+    // Universes are mostly consecutive, which the low bits spread without collisions
+    static constexpr uint32_t Hash(uint16_t key) { return key & kMask; }
+
+    struct Entry {
+        uint32_t port_mask;
+        uint16_t key;
+    };
+
+    Entry entry_[kEntries];
+};
+} // namespace e131bridge
+
+#endif // E131BRIDGE_PORTMAP_H_
@@ -2,7 +2,7 @@
  * @file e131controller.h
  *
  */
-/* Copyright (C) 2020-2025 by Arjan van Vught mailto:info@gd32-dmx.org
+/* Copyright (C) 2020-2026 by Arjan van Vught mailto:info@gd32-dmx.org
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -30,28 +30,43 @@
 
 #include "e131.h"
 #include "dmxnode.h"
+#include "network_udp.h"
 #include "softwaretimers.h"
 
-enum
-{
-    DEFAULT_SYNCHRONIZATION_ADDRESS = 5000
+namespace e131controller {
+#if defined(E131_CONTROLLER_MAX_UNIVERSES)
+inline constexpr uint32_t kMaxUniverses = E131_CONTROLLER_MAX_UNIVERSES;
+#else
+inline constexpr uint32_t kMaxUniverses = 512;
+#endif
+inline constexpr uint32_t kUniversesPerDiscoveryPage = 512;
+inline constexpr uint32_t kMaxDiscoveryPages = (kMaxUniverses + kUniversesPerDiscoveryPage - 1) / kUniversesPerDiscoveryPage;
+inline constexpr uint16_t kDefaultSynchronizationAddress = 5000;
+
+/**
+ * Prebuilt data packet, only the sequence number, the property values and the lengths change per frame.
+ */
+struct Universe {
+    e131::DataPacket packet;
+    uint32_t ip_address;
+    uint16_t universe;
+    uint8_t sequence_number;
+    bool is_pending;
 };
 
-struct TE131ControllerState
-{
-    uint16_t nActiveUniverses;
-    uint32_t DiscoveryTime;
-    uint8_t priority;
-    struct TSynchronizationPacket
-    {
-        uint16_t nUniverseNumber;
-        uint32_t nIpAddress;
-        uint8_t sequence_number;
-    } SynchronizationPacket;
+struct Synchronization {
+    uint32_t ip_address;
+    uint16_t address;
+    uint8_t sequence_number;
 };
 
-class E131Controller
-{
+struct Index {
+    uint16_t universe;
+    uint16_t slot; ///< Into the Universe array
+};
+} // namespace e131controller
+
+class E131Controller {
    public:
     E131Controller();
     ~E131Controller();
@@ -61,25 +76,23 @@ class E131Controller
 
     void Print();
 
-    void HandleDmxOut(uint16_t nUniverse, const uint8_t* pDmxData, uint32_t nLength);
+    /**
+     * Queues the universe for the next batch, the batch is sent with HandleSync.
+     */
+    void HandleDmxOut(uint16_t universe, const uint8_t* dmx_data, uint32_t length);
+    /**
+     * Sends the queued universes, followed by the synchronization packet.
+     */
     void HandleSync();
     void HandleBlackout();
 
-    void SetSynchronizationAddress(uint16_t nSynchronizationAddress = DEFAULT_SYNCHRONIZATION_ADDRESS)
-    {
-        state_.SynchronizationPacket.nUniverseNumber = nSynchronizationAddress;
-        state_.SynchronizationPacket.nIpAddress = e131::UniverseToMulticastIp(nSynchronizationAddress);
-    }
-    uint16_t GetSynchronizationAddress() const { return state_.SynchronizationPacket.nUniverseNumber; }
+    void SetSynchronizationAddress(uint16_t synchronization_address = e131controller::kDefaultSynchronizationAddress);
+    uint16_t GetSynchronizationAddress() const { return synchronization_.address; }
 
-    void SetMaster(uint32_t nMaster = dmxnode::kDmxMaxValue)
-    {
-        if (nMaster < dmxnode::kDmxMaxValue)
-        {
-            master_ = nMaster;
-        }
-        else
-        {
+    void SetMaster(uint32_t master = dmxnode::kDmxMaxValue) {
+        if (master < dmxnode::kDmxMaxValue) {
+            master_ = master;
+        } else {
             master_ = dmxnode::kDmxMaxValue;
         }
     }
@@ -87,34 +100,49 @@ class E131Controller
 
     const uint8_t* GetSoftwareVersion();
 
-    void SetSourceName(const char* pSourceName);
-    void SetPriority(uint8_t nPriority);
+    void SetSourceName(const char* source_name);
+    void SetPriority(uint8_t priority);
 
     static E131Controller* Get() { return s_this; }
 
    private:
-    void FillDataPacket();
+    void FillDataPacket(e131controller::Universe& universe);
     void FillDiscoveryPacket();
+    void UpdateDiscoveryPages();
     void FillSynchronizationPacket();
-    uint8_t GetSequenceNumber(uint16_t nUniverse, uint32_t& nMulticastIpAddress);
+    void UpdateTemplates();
+
+    e131controller::Universe* GetUniverse(uint16_t universe);
+    void SendBatch();
+    void SendSynchronization();
 
     void SendDiscoveryPacket();
 
-    void static StaticCallbackFunctionSendDiscoveryPacket([[maybe_unused]] TimerHandle_t timerHandle) { s_this->SendDiscoveryPacket(); }
+    void static StaticCallbackFunctionSendDiscoveryPacket([[maybe_unused]] TimerHandle_t timer_handle) { s_this->SendDiscoveryPacket(); }
 
    private:
     int32_t handle_{-1};
-    struct TE131ControllerState state_;
-    e131::DataPacket* m_pE131DataPacket{nullptr};
-    e131::DiscoveryPacket* m_pE131DiscoveryPacket{nullptr};
-    e131::SynchronizationPacket* m_pE131SynchronizationPacket{nullptr};
-    uint32_t m_DiscoveryIpAddress{0};
+    uint32_t active_universes_{0};
+    uint32_t pending_universes_{0};
+    uint32_t master_{dmxnode::kDmxMaxValue};
+    uint32_t discovery_ip_address_{0};
+    uint8_t priority_{e131::priority::kDefault};
     uint8_t cid_[e117::kCidLength];
     char source_name_[e131::kSourceNameLength];
-    uint32_t master_{dmxnode::kDmxMaxValue};
+
+    e131controller::Universe* universe_{nullptr};
+    e131controller::Index index_[e131controller::kMaxUniverses]; ///< Sorted on universe
+    uint16_t pending_[e131controller::kMaxUniverses];            ///< Slots in the order of HandleDmxOut
+    e131controller::Synchronization synchronization_;
+
+    e131::DiscoveryPacket* discovery_packet_{nullptr}; ///< One per page
+    uint32_t discovery_pages_{1};
+    uint32_t discovery_page_next_{0};
+    uint32_t discovery_dirty_page_{0}; ///< Pages from here on must be rebuilt, kMaxDiscoveryPages when none
+    e131::SynchronizationPacket* synchronization_packet_{nullptr};
     TimerHandle_t timer_handle_send_discovery_packet_{-1};
 
     static inline E131Controller* s_this;
 };
 
-#endif  // E131CONTROLLER_H_
+#endif // E131CONTROLLER_H_
@@ -1,7 +1,7 @@
 /**
  * @file e131controller.cpp
  */
-/* Copyright (C) 2020-2025 by Arjan van Vught mailto:info@gd32-dmx.org
+/* Copyright (C) 2020-2026 by Arjan van Vught mailto:info@gd32-dmx.org
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
 #include <cassert>
 
 #include "e131controller.h"
@@ -33,60 +34,42 @@
 #include "uuid.h"
 #include "board.h"
 #include "network.h"
+#include "network_udp.h"
 #include "softwaretimers.h"
 #include "firmware/debug/debug_debug.h"
 
-using namespace e131;
-
 static constexpr uint8_t kDeviceSoftwareVersion[] = {1, 0};
+static constexpr uint32_t kBatchMessages = 64;
 
-struct TSequenceNumbers
-{
-    uint16_t universe;
-    uint8_t sequence_number;
-    uint32_t ip_address;
-};
-
-static struct TSequenceNumbers s_SequenceNumbers[512] __attribute__((aligned(8)));
+static_assert(e131controller::kMaxUniverses <= 0xFFFF, "The slot is an uint16_t");
+static_assert(e131controller::kMaxDiscoveryPages <= 256, "The page is an uint8_t");
 
-E131Controller::E131Controller()
-{
+E131Controller::E131Controller() {
     DEBUG_ENTRY();
 
     assert(s_this == nullptr);
     s_this = this;
 
-    memset(&state_, 0, sizeof(struct TE131ControllerState));
-    state_.priority = 100;
-
-    char aSourceName[e131::kSourceNameLength];
-    uint8_t nLength;
-    snprintf(aSourceName, e131::kSourceNameLength, "%.48s %s", network::iface::HostName(), board::BoardName(nLength));
-    SetSourceName(aSourceName);
+    char source_name[e131::kSourceNameLength];
+    uint8_t length;
+    snprintf(source_name, e131::kSourceNameLength, "%.48s %s", network::iface::HostName(), board::BoardName(length));
+    SetSourceName(source_name);
 
     UuidCopy(cid_);
 
-    for (uint32_t nIndex = 0; nIndex < sizeof(s_SequenceNumbers) / sizeof(s_SequenceNumbers[0]); nIndex++)
-    {
-        memset(&s_SequenceNumbers[nIndex], 0, sizeof(s_SequenceNumbers[0]));
-    }
-
+    memset(&synchronization_, 0, sizeof(synchronization_));
     SetSynchronizationAddress();
 
-    const auto kIpMulticast = network::ConvertToUint(239, 255, 0, 0);
-    m_DiscoveryIpAddress = kIpMulticast | ((universe::kDiscovery & static_cast<uint32_t>(0xFF)) << 24) | ((universe::kDiscovery & 0xFF00) << 8);
+    discovery_ip_address_ = e131::UniverseToMulticastIp(e131::universe::kDiscovery);
 
-    // e131::DataPacket
-    m_pE131DataPacket = new struct e131::DataPacket;
-    assert(m_pE131DataPacket != nullptr);
+    universe_ = new e131controller::Universe[e131controller::kMaxUniverses];
+    assert(universe_ != nullptr);
 
-    // e131::DiscoveryPacket
-    m_pE131DiscoveryPacket = new struct e131::DiscoveryPacket;
-    assert(m_pE131DiscoveryPacket != nullptr);
+    discovery_packet_ = new e131::DiscoveryPacket[e131controller::kMaxDiscoveryPages];
+    assert(discovery_packet_ != nullptr);
 
-    // e131::SynchronizationPacket
-    m_pE131SynchronizationPacket = new struct e131::SynchronizationPacket;
-    assert(m_pE131SynchronizationPacket != nullptr);
+    synchronization_packet_ = new e131::SynchronizationPacket;
+    assert(synchronization_packet_ != nullptr);
 
     handle_ = network::udp::Begin(e131::kUdpPort, nullptr);
     assert(handle_ != -1);
@@ -94,301 +77,356 @@ E131Controller::E131Controller()
     DEBUG_EXIT();
 }
 
-E131Controller::~E131Controller()
-{
+E131Controller::~E131Controller() {
     DEBUG_ENTRY();
 
     network::udp::End(e131::kUdpPort);
 
-    if (m_pE131SynchronizationPacket != nullptr)
-    {
-        delete m_pE131SynchronizationPacket;
-        m_pE131SynchronizationPacket = nullptr;
-    }
+    delete synchronization_packet_;
+    synchronization_packet_ = nullptr;
 
-    if (m_pE131DiscoveryPacket != nullptr)
-    {
-        delete m_pE131DiscoveryPacket;
-        m_pE131DiscoveryPacket = nullptr;
-    }
+    delete[] discovery_packet_;
+    discovery_packet_ = nullptr;
 
-    if (m_pE131DataPacket != nullptr)
-    {
-        delete m_pE131DataPacket;
-        m_pE131DataPacket = nullptr;
-    }
+    delete[] universe_;
+    universe_ = nullptr;
 
     DEBUG_EXIT();
 }
 
-void E131Controller::Start()
-{
+void E131Controller::Start() {
     DEBUG_ENTRY();
 
-    FillDataPacket();
     FillDiscoveryPacket();
     FillSynchronizationPacket();
 
-    timer_handle_send_discovery_packet_ = SoftwareTimerAdd(e131::kUniverseDiscoveryIntervalSeconds * 1000U, StaticCallbackFunctionSendDiscoveryPacket);
+    timer_handle_send_discovery_packet_ = SoftwareTimerAdd((e131::kUniverseDiscoveryIntervalSeconds * 1000U) / discovery_pages_, StaticCallbackFunctionSendDiscoveryPacket);
     assert(timer_handle_send_discovery_packet_ >= 0);
 
     DEBUG_EXIT();
 }
 
-void E131Controller::Stop()
-{
+void E131Controller::Stop() {
     SoftwareTimerDelete(timer_handle_send_discovery_packet_);
 }
 
-void E131Controller::FillDataPacket()
-{
+void E131Controller::FillDataPacket(e131controller::Universe& universe) {
+    auto& packet = universe.packet;
+
     // Root Layer (See Section 5)
-    m_pE131DataPacket->root_layer.pre_amble_size = __builtin_bswap16(0x0010);
-    m_pE131DataPacket->root_layer.post_amble_size = __builtin_bswap16(0x0000);
-    memcpy(m_pE131DataPacket->root_layer.acn_packet_identifier, e117::kAcnPacketIdentifier, e117::kAcnPacketIdentifierLength);
-    m_pE131DataPacket->root_layer.vector = __builtin_bswap32(vector::root::kData);
-    memcpy(m_pE131DataPacket->root_layer.cid, cid_, e117::kCidLength);
+    packet.root_layer.pre_amble_size = __builtin_bswap16(0x0010);
+    packet.root_layer.post_amble_size = __builtin_bswap16(0x0000);
+    memcpy(packet.root_layer.acn_packet_identifier, e117::kAcnPacketIdentifier, e117::kAcnPacketIdentifierLength);
+    packet.root_layer.vector = __builtin_bswap32(e131::vector::root::kData);
+    memcpy(packet.root_layer.cid, cid_, e117::kCidLength);
 
     // E1.31 Framing Layer (See Section 6)
-    m_pE131DataPacket->frame_layer.vector = __builtin_bswap32(vector::data::kPacket);
-    memcpy(m_pE131DataPacket->frame_layer.source_name, source_name_, e131::kSourceNameLength);
-    m_pE131DataPacket->frame_layer.priority = state_.priority;
-    m_pE131DataPacket->frame_layer.synchronization_address = __builtin_bswap16(state_.SynchronizationPacket.nUniverseNumber);
-    m_pE131DataPacket->frame_layer.options = 0;
+    packet.frame_layer.vector = __builtin_bswap32(e131::vector::data::kPacket);
+    memcpy(packet.frame_layer.source_name, source_name_, e131::kSourceNameLength);
+    packet.frame_layer.priority = priority_;
+    packet.frame_layer.synchronization_address = __builtin_bswap16(synchronization_.address);
+    packet.frame_layer.options = 0;
+    packet.frame_layer.universe = __builtin_bswap16(universe.universe);
 
     // Data Layer
-    m_pE131DataPacket->dmp_layer.vector = e131::vector::dmp::kSetProperty;
-    m_pE131DataPacket->dmp_layer.type = 0xa1;
-    m_pE131DataPacket->dmp_layer.first_address_property = __builtin_bswap16(0x0000);
-    m_pE131DataPacket->dmp_layer.address_increment = __builtin_bswap16(0x0001);
-    m_pE131DataPacket->dmp_layer.property_values[0] = 0;
+    packet.dmp_layer.vector = e131::vector::dmp::kSetProperty;
+    packet.dmp_layer.type = 0xa1;
+    packet.dmp_layer.first_address_property = __builtin_bswap16(0x0000);
+    packet.dmp_layer.address_increment = __builtin_bswap16(0x0001);
+    packet.dmp_layer.property_values[0] = e131::startcode::kDmx;
 }
 
-void E131Controller::FillDiscoveryPacket()
-{
-    memset(m_pE131DiscoveryPacket, 0, sizeof(struct e131::DiscoveryPacket));
+void E131Controller::FillDiscoveryPacket() {
+    for (uint32_t page = 0; page < e131controller::kMaxDiscoveryPages; page++) {
+        auto& packet = discovery_packet_[page];
 
-    // Root Layer (See Section 5)
-    m_pE131DiscoveryPacket->root_layer.pre_amble_size = __builtin_bswap16(0x10);
-    memcpy(m_pE131DiscoveryPacket->root_layer.acn_packet_identifier, e117::kAcnPacketIdentifier, e117::kAcnPacketIdentifierLength);
-    m_pE131DiscoveryPacket->root_layer.vector = __builtin_bswap32(vector::root::kExtended);
-    memcpy(m_pE131DiscoveryPacket->root_layer.cid, cid_, e117::kCidLength);
+        memset(&packet, 0, sizeof(struct e131::DiscoveryPacket));
 
-    // E1.31 Framing Layer (See Section 6)
-    m_pE131DiscoveryPacket->frame_layer.vector = __builtin_bswap32(vector::extended::kDiscovery);
-    memcpy(m_pE131DiscoveryPacket->frame_layer.source_name, source_name_, e131::kSourceNameLength);
+        // Root Layer (See Section 5)
+        packet.root_layer.pre_amble_size = __builtin_bswap16(0x10);
+        memcpy(packet.root_layer.acn_packet_identifier, e117::kAcnPacketIdentifier, e117::kAcnPacketIdentifierLength);
+        packet.root_layer.vector = __builtin_bswap32(e131::vector::root::kExtended);
+        memcpy(packet.root_layer.cid, cid_, e117::kCidLength);
 
-    // Universe Discovery Layer (See Section 8)
-    m_pE131DiscoveryPacket->universe_discovery_layer.vector = __builtin_bswap32(vector::universe::kDiscoveryUniverseList);
+        // E1.31 Framing Layer (See Section 6)
+        packet.frame_layer.vector = __builtin_bswap32(e131::vector::extended::kDiscovery);
+        memcpy(packet.frame_layer.source_name, source_name_, e131::kSourceNameLength);
+
+        // Universe Discovery Layer (See Section 8)
+        packet.universe_discovery_layer.vector = __builtin_bswap32(e131::vector::universe::kDiscoveryUniverseList);
+        packet.universe_discovery_layer.page = static_cast<uint8_t>(page);
+    }
+
+    discovery_dirty_page_ = 0;
 }
 
-void E131Controller::FillSynchronizationPacket()
-{
-    memset(m_pE131SynchronizationPacket, 0, sizeof(struct e131::SynchronizationPacket));
+/**
+ * Only the pages from the first changed one are rebuilt. A new universe
+ * shifts the sorted list from its position onwards, the pages before are not touched.
+ */
+void E131Controller::UpdateDiscoveryPages() {
+    if (discovery_dirty_page_ == e131controller::kMaxDiscoveryPages) {
+        return;
+    }
 
-    // Root Layer (See Section 4.2)
-    m_pE131SynchronizationPacket->root_layer.pre_amble_size = __builtin_bswap16(0x10);
-    memcpy(m_pE131SynchronizationPacket->root_layer.acn_packet_identifier, e117::kAcnPacketIdentifier, e117::kAcnPacketIdentifierLength);
-    m_pE131SynchronizationPacket->root_layer.flags_length = __builtin_bswap16((0x07 << 12) | (e131::kSynchronizationRootLayerSize));
-    m_pE131SynchronizationPacket->root_layer.vector = __builtin_bswap32(vector::root::kExtended);
-    memcpy(m_pE131SynchronizationPacket->root_layer.cid, cid_, e117::kCidLength);
+    const auto kPages = (active_universes_ == 0) ? 1 : (active_universes_ + e131controller::kUniversesPerDiscoveryPage - 1) / e131controller::kUniversesPerDiscoveryPage;
+    const auto kLastPage = static_cast<uint8_t>(kPages - 1);
 
-    // E1.31 Framing Layer (See Section 6)
-    m_pE131SynchronizationPacket->frame_layer.flags_length = __builtin_bswap16((0x07 << 12) | (e131::kSynchronizationFrameLayerSize));
-    m_pE131SynchronizationPacket->frame_layer.vector = __builtin_bswap32(vector::extended::kSynchronization);
-    m_pE131SynchronizationPacket->frame_layer.universe_number = __builtin_bswap16(state_.SynchronizationPacket.nUniverseNumber);
+    for (uint32_t page = discovery_dirty_page_; page < kPages; page++) {
+        auto& packet = discovery_packet_[page];
+        const auto kFirst = page * e131controller::kUniversesPerDiscoveryPage;
+        const auto kUniverses = std::min(active_universes_ - kFirst, e131controller::kUniversesPerDiscoveryPage);
+
+        packet.root_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DiscoveryRootLayerLength(kUniverses))));
+        packet.frame_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DiscoveryFrameLayerLength(kUniverses))));
+        packet.universe_discovery_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | e131::DiscoveryLayerLength(kUniverses)));
+
+        for (uint32_t i = 0; i < kUniverses; i++) {
+            packet.universe_discovery_layer.list_of_universes[i] = __builtin_bswap16(index_[kFirst + i].universe);
+        }
+    }
+
+    for (uint32_t page = 0; page < kPages; page++) {
+        discovery_packet_[page].universe_discovery_layer.last_page = kLastPage;
+    }
+
+    if (kPages != discovery_pages_) {
+        discovery_pages_ = kPages;
+        // All pages are sent within one E131_UNIVERSE_DISCOVERY_INTERVAL
+        SoftwareTimerChange(timer_handle_send_discovery_packet_, (e131::kUniverseDiscoveryIntervalSeconds * 1000U) / kPages);
+    }
+
+    discovery_dirty_page_ = e131controller::kMaxDiscoveryPages;
 }
 
-void E131Controller::HandleDmxOut(uint16_t nUniverse, const uint8_t* pDmxData, uint32_t nLength)
-{
-    uint32_t ip;
+void E131Controller::FillSynchronizationPacket() {
+    memset(synchronization_packet_, 0, sizeof(struct e131::SynchronizationPacket));
 
-    // Root Layer (See Section 5)
-    m_pE131DataPacket->root_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DataRootLayerLength(1U + nLength))));
+    // Root Layer (See Section 4.2)
+    synchronization_packet_->root_layer.pre_amble_size = __builtin_bswap16(0x10);
+    memcpy(synchronization_packet_->root_layer.acn_packet_identifier, e117::kAcnPacketIdentifier, e117::kAcnPacketIdentifierLength);
+    synchronization_packet_->root_layer.flags_length = __builtin_bswap16((0x07 << 12) | (e131::kSynchronizationRootLayerSize));
+    synchronization_packet_->root_layer.vector = __builtin_bswap32(e131::vector::root::kExtended);
+    memcpy(synchronization_packet_->root_layer.cid, cid_, e117::kCidLength);
 
     // E1.31 Framing Layer (See Section 6)
-    m_pE131DataPacket->frame_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DataFrameLayerLength(1U + nLength))));
-    m_pE131DataPacket->frame_layer.sequence_number = GetSequenceNumber(nUniverse, ip);
-    m_pE131DataPacket->frame_layer.universe = __builtin_bswap16(nUniverse);
+    synchronization_packet_->frame_layer.flags_length = __builtin_bswap16((0x07 << 12) | (e131::kSynchronizationFrameLayerSize));
+    synchronization_packet_->frame_layer.vector = __builtin_bswap32(e131::vector::extended::kSynchronization);
+}
 
-    // Data Layer
-    m_pE131DataPacket->dmp_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DataLayerLength(1U + nLength))));
+void E131Controller::UpdateTemplates() {
+    if (universe_ == nullptr) {
+        return;
+    }
 
-    if (__builtin_expect((master_ == dmxnode::kDmxMaxValue), 1))
-    {
-        memcpy(&m_pE131DataPacket->dmp_layer.property_values[1], pDmxData, nLength);
+    for (uint32_t slot = 0; slot < active_universes_; slot++) {
+        auto& universe = universe_[slot];
+        FillDataPacket(universe);
     }
-    else if (master_ == 0)
-    {
-        memset(&m_pE131DataPacket->dmp_layer.property_values[1], 0, nLength);
+}
+
+void E131Controller::SetSynchronizationAddress(uint16_t synchronization_address) {
+    synchronization_.address = synchronization_address;
+    synchronization_.ip_address = (synchronization_address != 0) ? e131::UniverseToMulticastIp(synchronization_address) : 0;
+
+    UpdateTemplates();
+}
+
+e131controller::Universe* E131Controller::GetUniverse(uint16_t universe) {
+    auto* const kEnd = &index_[active_universes_];
+    auto* it = std::lower_bound(index_, kEnd, universe, [](const e131controller::Index& index, uint16_t value) { return index.universe < value; });
+
+    if ((it != kEnd) && (it->universe == universe)) {
+        return &universe_[it->slot];
     }
-    else
-    {
-        for (uint32_t i = 0; i < nLength; i++)
-        {
-            m_pE131DataPacket->dmp_layer.property_values[1 + i] = static_cast<uint8_t>((master_ * pDmxData[i]) / dmxnode::kDmxMaxValue);
-        }
+
+    if (active_universes_ == e131controller::kMaxUniverses) {
+        DEBUG_PRINTF("Max universes reached -> %u", universe);
+        return nullptr;
     }
 
-    m_pE131DataPacket->dmp_layer.property_value_count = __builtin_bswap16(static_cast<uint16_t>(1 + nLength));
+    // New universe: build its template once
+    memmove(it + 1, it, static_cast<size_t>(kEnd - it) * sizeof(e131controller::Index));
+
+    const auto kSlot = static_cast<uint16_t>(active_universes_++);
+    discovery_dirty_page_ = std::min(discovery_dirty_page_, static_cast<uint32_t>(it - index_) / e131controller::kUniversesPerDiscoveryPage);
+
+    it->universe = universe;
+    it->slot = kSlot;
 
-    network::udp::Send(handle_, reinterpret_cast<const uint8_t*>(m_pE131DataPacket), static_cast<uint16_t>(e131::DataPacketSize(1U + nLength)), ip, e131::kUdpPort);
+    auto& new_universe = universe_[kSlot];
+
+    new_universe.ip_address = e131::UniverseToMulticastIp(universe);
+    new_universe.universe = universe;
+    new_universe.sequence_number = 0;
+    new_universe.is_pending = false;
+
+    FillDataPacket(new_universe);
+
+    DEBUG_PRINTF("universe=%u, slot=%u", universe, kSlot);
+    return &new_universe;
 }
 
-void E131Controller::HandleSync()
-{
-    if (state_.SynchronizationPacket.nUniverseNumber != 0)
-    {
-        m_pE131SynchronizationPacket->frame_layer.sequence_number = state_.SynchronizationPacket.sequence_number++;
-        network::udp::Send(handle_, reinterpret_cast<const uint8_t*>(m_pE131SynchronizationPacket), e131::kSynchronizationPacketSize,
-                       state_.SynchronizationPacket.nIpAddress, e131::kUdpPort);
+void E131Controller::HandleDmxOut(uint16_t universe, const uint8_t* dmx_data, uint32_t length) {
+    auto* target = GetUniverse(universe);
+
+    if (__builtin_expect((target == nullptr), 0)) {
+        return;
     }
-}
 
-void E131Controller::HandleBlackout()
-{
+    if (target->is_pending) {
+        // Same universe twice in one frame: send what is queued first
+        SendBatch();
+    }
+
+    length = std::min(length, static_cast<uint32_t>(e131::kDmxLength));
+
+    auto& packet = target->packet;
+
     // Root Layer (See Section 5)
-    m_pE131DataPacket->root_layer.flags_length = __builtin_bswap16((0x07 << 12) | (e131::DataRootLayerLength(513)));
+    packet.root_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DataRootLayerLength(1U + length))));
 
     // E1.31 Framing Layer (See Section 6)
-    m_pE131DataPacket->frame_layer.flags_length = __builtin_bswap16((0x07 << 12) | (e131::DataFrameLayerLength(513)));
+    packet.frame_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DataFrameLayerLength(1U + length))));
+    packet.frame_layer.sequence_number = target->sequence_number++;
 
     // Data Layer
-    m_pE131DataPacket->dmp_layer.flags_length = __builtin_bswap16((0x07 << 12) | (e131::DataLayerLength(513)));
-    m_pE131DataPacket->dmp_layer.property_value_count = __builtin_bswap16(513);
-    memset(&m_pE131DataPacket->dmp_layer.property_values[1], 0, 512);
+    packet.dmp_layer.flags_length = __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DataLayerLength(1U + length))));
+
+    if (__builtin_expect((master_ == dmxnode::kDmxMaxValue), 1)) {
+        memcpy(&packet.dmp_layer.property_values[1], dmx_data, length);
+    } else if (master_ == 0) {
+        memset(&packet.dmp_layer.property_values[1], 0, length);
+    } else {
+        for (uint32_t i = 0; i < length; i++) {
+            packet.dmp_layer.property_values[1 + i] = static_cast<uint8_t>((master_ * dmx_data[i]) / dmxnode::kDmxMaxValue);
+        }
+    }
 
-    for (uint32_t nIndex = 0; nIndex < state_.nActiveUniverses; nIndex++)
-    {
-        uint32_t ip;
-        uint16_t nUniverse = s_SequenceNumbers[nIndex].universe;
+    packet.dmp_layer.property_value_count = __builtin_bswap16(static_cast<uint16_t>(1 + length));
 
-        m_pE131DataPacket->frame_layer.sequence_number = GetSequenceNumber(nUniverse, ip);
-        m_pE131DataPacket->frame_layer.universe = __builtin_bswap16(nUniverse);
+    target->is_pending = true;
+    pending_[pending_universes_++] = static_cast<uint16_t>(target - universe_);
+}
 
-        network::udp::Send(handle_, reinterpret_cast<const uint8_t*>(m_pE131DataPacket), e131::DataPacketSize(513), ip, e131::kUdpPort);
-    }
+void E131Controller::SendBatch() {
+    network::udp::Message messages[kBatchMessages];
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < pending_universes_; i++) {
+        auto& universe = universe_[pending_[i]];
+        universe.is_pending = false;
 
-    if (state_.SynchronizationPacket.nUniverseNumber != 0)
-    {
-        HandleSync();
+        auto& message = messages[count++];
+        message.data = reinterpret_cast<const uint8_t*>(&universe.packet);
+        message.size = e131::DataPacketSize(__builtin_bswap16(universe.packet.dmp_layer.property_value_count));
+        message.remote_ip = universe.ip_address;
+        message.remote_port = e131::kUdpPort;
+
+        if (count == kBatchMessages) {
+            network::udp::SendBatch(handle_, messages, count);
+            count = 0;
+        }
     }
-}
 
-const uint8_t* E131Controller::GetSoftwareVersion()
-{
-    return kDeviceSoftwareVersion;
-}
+    if (count != 0) {
+        network::udp::SendBatch(handle_, messages, count);
+    }
 
-void E131Controller::SetSourceName(const char* pSourceName)
-{
-    assert(pSourceName != nullptr);
-    strncpy(source_name_, pSourceName, e131::kSourceNameLength - 1);
-    source_name_[e131::kSourceNameLength - 1] = '\0';
+    pending_universes_ = 0;
 }
 
-void E131Controller::SetPriority(uint8_t priority)
-{ // TODO (a) SetPriority
-    state_.priority = priority;
-}
+void E131Controller::SendSynchronization() {
+    if (synchronization_.address == 0) {
+        return;
+    }
 
-void E131Controller::SendDiscoveryPacket()
-{
-    assert(m_DiscoveryIpAddress != 0);
+    synchronization_packet_->frame_layer.sequence_number = synchronization_.sequence_number++;
+    synchronization_packet_->frame_layer.universe_number = __builtin_bswap16(synchronization_.address);
 
-    m_pE131DiscoveryPacket->root_layer.flags_length =
-        __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DiscoveryRootLayerLength(state_.nActiveUniverses))));
-    m_pE131DiscoveryPacket->frame_layer.flags_length =
-        __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | (e131::DiscoveryFrameLayerLength(state_.nActiveUniverses))));
-    m_pE131DiscoveryPacket->universe_discovery_layer.flags_length =
-        __builtin_bswap16(static_cast<uint16_t>((0x07 << 12) | e131::DiscoveryLayerLength(state_.nActiveUniverses)));
+    network::udp::Send(handle_, reinterpret_cast<const uint8_t*>(synchronization_packet_), e131::kSynchronizationPacketSize, synchronization_.ip_address, e131::kUdpPort);
+}
 
-    for (uint32_t i = 0; i < state_.nActiveUniverses; i++)
-    {
-        m_pE131DiscoveryPacket->universe_discovery_layer.list_of_universes[i] = __builtin_bswap16(s_SequenceNumbers[i].universe);
+void E131Controller::HandleSync() {
+    if (pending_universes_ == 0) {
+        return;
     }
 
-    network::udp::Send(handle_, reinterpret_cast<const uint8_t*>(m_pE131DiscoveryPacket), static_cast<uint16_t>(e131::DiscoveryPacketSize(state_.nActiveUniverses)),
-                   m_DiscoveryIpAddress, e131::kUdpPort);
-
-    DEBUG_PUTS("Discovery sent");
+    SendBatch();
+    SendSynchronization();
 }
 
-uint8_t E131Controller::GetSequenceNumber(uint16_t nUniverse, uint32_t& nMulticastIpAddress)
-{
-    assert(sizeof(struct TSequenceNumbers) == sizeof(uint64_t));
+void E131Controller::HandleBlackout() {
+    // Whatever is queued is overruled by the blackout
+    for (uint32_t i = 0; i < pending_universes_; i++) {
+        universe_[pending_[i]].is_pending = false;
+    }
 
-    int32_t nLow = 0;
-    int32_t nMid = 0;
-    int32_t nHigh = state_.nActiveUniverses;
+    pending_universes_ = 0;
 
-    while (nLow <= nHigh)
-    {
-        nMid = nLow + ((nHigh - nLow) / 2);
+    static constexpr uint8_t kBlackout[e131::kDmxLength] = {};
+    const auto kMaster = master_;
 
-        const uint32_t nMidValue = s_SequenceNumbers[nMid].universe;
+    master_ = dmxnode::kDmxMaxValue;
 
-        if (nMidValue < nUniverse)
-        {
-            nLow = nMid + 1;
-        }
-        else if (nMidValue > nUniverse)
-        {
-            nHigh = nMid - 1;
-        }
-        else
-        {
-            DEBUG_PRINTF("Found nUniverse=%u", nUniverse);
-            nMulticastIpAddress = s_SequenceNumbers[nMid].ip_address;
-            s_SequenceNumbers[nMid].sequence_number++;
-            return s_SequenceNumbers[nMid].sequence_number;
-        }
+    for (uint32_t i = 0; i < active_universes_; i++) {
+        HandleDmxOut(index_[i].universe, kBlackout, e131::kDmxLength);
     }
 
-    DEBUG_PRINTF("nActiveUniverses=%u -> %u : nLow=%d, nMid=%d, nHigh=%d", state_.nActiveUniverses, nUniverse, nLow, nMid, nHigh);
+    master_ = kMaster;
 
-    if ((nHigh != -1) && (state_.nActiveUniverses != static_cast<uint32_t>(nHigh)))
-    {
-        auto p64 = reinterpret_cast<uint64_t*>(s_SequenceNumbers);
+    HandleSync();
+}
 
-        for (int32_t i = state_.nActiveUniverses - 1; i >= nLow; i--)
-        {
-            p64[i + 1] = p64[i];
-        }
+const uint8_t* E131Controller::GetSoftwareVersion() {
+    return kDeviceSoftwareVersion;
+}
 
-        s_SequenceNumbers[nLow].ip_address = UniverseToMulticastIp(nUniverse);
-        s_SequenceNumbers[nLow].universe = nUniverse;
-        s_SequenceNumbers[nLow].sequence_number = 0;
+void E131Controller::SetSourceName(const char* source_name) {
+    assert(source_name != nullptr);
+    strncpy(source_name_, source_name, e131::kSourceNameLength - 1);
+    source_name_[e131::kSourceNameLength - 1] = '\0';
 
-        nMulticastIpAddress = s_SequenceNumbers[nLow].ip_address;
+    if (discovery_packet_ != nullptr) {
+        FillDiscoveryPacket();
+    }
 
-        DEBUG_PRINTF(">m< nUniverse=%u, nLow=%d", nUniverse, nLow);
+    UpdateTemplates();
+}
+
+void E131Controller::SetPriority(uint8_t priority) {
+    if ((priority >= e131::priority::kLowest) && (priority <= e131::priority::kHighest)) {
+        priority_ = priority;
+        UpdateTemplates();
     }
-    else
-    {
-        s_SequenceNumbers[nMid].ip_address = UniverseToMulticastIp(nUniverse);
-        s_SequenceNumbers[nMid].universe = nUniverse;
+}
 
-        nMulticastIpAddress = s_SequenceNumbers[nMid].ip_address;
+void E131Controller::SendDiscoveryPacket() {
+    assert(discovery_ip_address_ != 0);
 
-        DEBUG_PRINTF(">a< nUniverse=%u, nMid=%d", nUniverse, nMid);
+    UpdateDiscoveryPages();
+
+    if (discovery_page_next_ >= discovery_pages_) {
+        discovery_page_next_ = 0;
     }
 
-    state_.nActiveUniverses++;
+    const auto& packet = discovery_packet_[discovery_page_next_];
+    const auto kUniverses = std::min(active_universes_ - discovery_page_next_ * e131controller::kUniversesPerDiscoveryPage, e131controller::kUniversesPerDiscoveryPage);
+
+    network::udp::Send(handle_, reinterpret_cast<const uint8_t*>(&packet), static_cast<uint16_t>(e131::DiscoveryPacketSize(kUniverses)), discovery_ip_address_, e131::kUdpPort);
+
+    DEBUG_PRINTF("Discovery page %u/%u sent", static_cast<unsigned>(discovery_page_next_), static_cast<unsigned>(discovery_pages_ - 1));
 
-    return 0;
+    discovery_page_next_++;
 }
 
-void E131Controller::Print()
-{
+void E131Controller::Print() {
     puts("sACN E1.31 Controller");
-    printf(" Max Universes : %d\n", static_cast<int>(sizeof(s_SequenceNumbers) / sizeof(s_SequenceNumbers[0])));
-    if (state_.SynchronizationPacket.nUniverseNumber != 0)
-    {
-        printf(" Synchronization Universe : %u\n", state_.SynchronizationPacket.nUniverseNumber);
-    }
-    else
-    {
+    printf(" Max Universes : %u\n", static_cast<unsigned>(e131controller::kMaxUniverses));
+
+    if (synchronization_.address != 0) {
+        printf(" Synchronization Universe : %u\n", synchronization_.address);
+    } else {
         puts(" Synchronization is disabled");
     }
 }
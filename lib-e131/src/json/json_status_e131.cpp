@@ -0,0 +1,90 @@
+/**
+ * @file json_status_e131.cpp
+ *
+ */
+/* Copyright (C) 2026 by Arjan van Vught mailto:info@gd32-dmx.org
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <uuid/uuid.h>
+
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+#include "e131bridge.h"
+#include "ip4/ip4_address.h"
+#include "timing.h"
+
+namespace json::status {
+static constexpr auto kUuidStringLength = 36;
+
+/**
+ * The sources announced with E1.31 Universe Discovery
+ */
+uint32_t E131Sources(char* out_buffer, uint32_t out_buffer_size) {
+    const auto& table = E131Bridge::Get()->GetDiscoveryTable();
+    const auto kMillis = timing::Millis();
+
+    out_buffer[0] = '[';
+    uint32_t length = 1;
+
+    for (uint32_t index = 0; index < e131bridge::DiscoveryTable::kEntries; index++) {
+        const auto* source = table.Get(index, kMillis);
+
+        if (source == nullptr) {
+            continue;
+        }
+
+        char uuid_str[kUuidStringLength + 1];
+        uuid_str[kUuidStringLength] = '\0';
+        uuid_unparse(source->cid, uuid_str);
+
+        char name[e131::kSourceNameLength];
+        uint32_t i;
+
+        for (i = 0; (i < (e131::kSourceNameLength - 1)) && (source->source_name[i] != '\0'); i++) {
+            const auto kChar = source->source_name[i];
+            name[i] = ((kChar == '"') || (kChar == '\\') || (kChar < ' ')) ? '_' : kChar;
+        }
+
+        name[i] = '\0';
+
+        const auto kSize = static_cast<uint32_t>(snprintf(&out_buffer[length], out_buffer_size - length,
+            "{\"cid\":\"%s\",\"name\":\"%s\",\"ip\":\"" IPSTR "\",\"universes\":\"%u\",\"first\":\"%u\",\"last\":\"%u\"},",
+            uuid_str, name, IP2STR(source->ip), static_cast<unsigned>(source->universes),
+            static_cast<unsigned>(source->universes != 0 ? source->first_universe : 0), static_cast<unsigned>(source->last_universe)));
+
+        if (kSize >= (out_buffer_size - length)) {
+            break;
+        }
+
+        length += kSize;
+    }
+
+    if (length == 1) {
+        out_buffer[length++] = ']';
+    } else {
+        out_buffer[length - 1] = ']';
+    }
+
+    return length;
+}
+} // namespace json::status
+#endif
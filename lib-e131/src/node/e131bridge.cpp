@@ -65,13 +65,16 @@ E131Bridge::E131Bridge() {
     }
 
     memset(&state_, 0, sizeof(e131bridge::State));
-    state_.priority = e131::priority::kLowest;
     state_.failsafe = dmxnode::FailSafe::kHold;
 
     for (uint32_t i = 0; i < dmxnode::kMaxPorts; i++) {
         memset(&output_port_[i], 0, sizeof(e131bridge::OutputPort));
+        output_port_[i].priority = e131::priority::kLowest;
         memset(&input_port_[i], 0, sizeof(e131bridge::InputPort));
         input_port_[i].priority = 100;
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+        memset(&per_address_priority_[i], 0, sizeof(e131bridge::PerAddressPriority));
+#endif
     }
 
 #if defined(E131_HAVE_DMXIN) || defined(NODE_SHOWFILE)
@@ -112,6 +115,10 @@ void E131Bridge::GetLongNameDefault(char* long_name) {
 }
 
 void E131Bridge::Start() {
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+    network::igmp::JoinGroup(handle_, e131::UniverseToMulticastIp(e131::universe::kDiscovery));
+#endif
+
 #if defined(E131_HAVE_DMXIN)
     const auto kIpMulticast = network::ConvertToUint(239, 255, 0, 0);
     discovery_ip_address_ = kIpMulticast | ((e131::universe::kDiscovery & static_cast<uint32_t>(0xFF)) << 24) | ((e131::universe::kDiscovery & 0xFF00) << 8);
@@ -165,6 +172,11 @@ void E131Bridge::Stop() {
     }
 #endif
 
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+    network::igmp::LeaveGroup(handle_, e131::UniverseToMulticastIp(e131::universe::kDiscovery));
+    discovery_table_.Clear();
+#endif
+
     state_.status = e131bridge::Status::kOff;
     board::statusled::SetMode(board::statusled::Mode::kOffOff);
 }
@@ -255,6 +267,26 @@ void E131Bridge::LeaveUniverse(uint32_t port_index, uint16_t universe) {
     DEBUG_EXIT();
 }
 
+void E131Bridge::UpdateUniverseMap() {
+    universe_map_.Clear();
+
+    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+        if (bridge_.port[port_index].direction == dmxnode::Direction::kOutput) {
+            universe_map_.Add(bridge_.port[port_index].universe, port_index);
+        }
+    }
+}
+
+void E131Bridge::UpdateSynchronizationMap() {
+    synchronization_map_.Clear();
+
+    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+        if (bridge_.port[port_index].direction == dmxnode::Direction::kOutput) {
+            synchronization_map_.Add(output_port_[port_index].synchronization_address, port_index);
+        }
+    }
+}
+
 void E131Bridge::SetLocalMerging() {
     DEBUG_ENTRY();
 
@@ -315,6 +347,8 @@ void E131Bridge::SetUniverse(uint32_t port_index, uint16_t universe) {
     bridge_.port[port_index].universe = universe;
     input_port_[port_index].multicast_ip = e131::UniverseToMulticastIp(universe);
 
+    UpdateUniverseMap();
+
 #if defined(E131_HAVE_DMXIN)
     if (state_.status == e131bridge::Status::kOn) {
         SetLocalMerging();
@@ -382,6 +416,9 @@ void E131Bridge::SetDirection(uint32_t port_index, dmxnode::Direction port_direc
         bridge_.port[port_index].direction = dmxnode::Direction::kOutput;
     }
 
+    UpdateUniverseMap();
+    UpdateSynchronizationMap();
+
 #if defined(E131_HAVE_DMXIN)
     if (state_.status == e131bridge::Status::kOn) {
         SetLocalMerging();
@@ -431,6 +468,10 @@ void E131Bridge::Print() {
         printf(" Synchronize is disabled\n");
     }
 
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+    printf(" Discovery table : %u sources\n", static_cast<unsigned int>(e131bridge::DiscoveryTable::kMaxSources));
+#endif
+
 #if defined(NODE_RDMNET_LLRP_ONLY)
     LLRPDevice::Print();
 #endif
@@ -494,7 +535,10 @@ void E131Bridge::HandleSynchronization() {
     const auto& synchronization_packet = *reinterpret_cast<const e131::SynchronizationPacket*>(receive_buffer_);
     const auto kSynchronizationAddress = __builtin_bswap16(synchronization_packet.frame_layer.universe_number);
 
-    if ((kSynchronizationAddress != state_.synchronization_address_source_a) && (kSynchronizationAddress != state_.synchronization_address_source_b)) {
+    // With a patch the destination ports are synchronized with their sources
+    const auto kPortMask = dmxnode::OutputPortMask(synchronization_map_.Find(kSynchronizationAddress));
+
+    if (kPortMask == 0) {
         board::statusled::SetMode(board::statusled::Mode::kNormal);
         DEBUG_PUTS("");
         return;
@@ -502,15 +546,17 @@ void E131Bridge::HandleSynchronization() {
 
     state_.synchronization_time = packet_millis_;
 
-    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
-        if (output_port_[port_index].is_data_pending) {
-            dmxnode_output_type_->Sync(port_index);
+    for (auto port_mask = kPortMask; port_mask != 0; port_mask &= (port_mask - 1)) {
+        const auto kPortIndex = static_cast<uint32_t>(__builtin_ctz(port_mask));
+        if (output_port_[kPortIndex].is_data_pending) {
+            dmxnode_output_type_->Sync(kPortIndex);
         }
     }
 
     dmxnode_output_type_->Sync();
 
-    for (auto& output_port : output_port_) {
+    for (auto port_mask = kPortMask; port_mask != 0; port_mask &= (port_mask - 1)) {
+        auto& output_port = output_port_[__builtin_ctz(port_mask)];
         if (output_port.is_data_pending) {
             output_port.is_data_pending = false;
             if (!output_port.is_transmitting) {
@@ -525,6 +571,18 @@ void E131Bridge::HandleSynchronization() {
     }
 }
 
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+void E131Bridge::HandleDiscovery(uint32_t size) {
+    const auto& discovery_packet = *reinterpret_cast<const e131::DiscoveryPacket*>(receive_buffer_);
+
+    if (discovery_packet.universe_discovery_layer.vector != __builtin_bswap32(e131::vector::universe::kDiscoveryUniverseList)) {
+        return;
+    }
+
+    discovery_table_.Update(discovery_packet, size, ip_address_from_, packet_millis_);
+}
+#endif
+
 void E131Bridge::InputUdp(const uint8_t* buffer, [[maybe_unused]] uint32_t size, [[maybe_unused]] uint32_t from_ip, [[maybe_unused]] uint16_t from_port) {
     if (__builtin_expect((!IsValidRoot(buffer)), 0)) {
         return;
@@ -556,6 +614,10 @@ void E131Bridge::InputUdp(const uint8_t* buffer, [[maybe_unused]] uint32_t size,
             const auto kFramingVector = __builtin_bswap32(kRaw->frame_layer.vector);
             if (kFramingVector == e131::vector::extended::kSynchronization) {
                 HandleSynchronization();
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+            } else if (kFramingVector == e131::vector::extended::kDiscovery) {
+                HandleDiscovery(size);
+#endif
             }
         } else {
             DEBUG_PRINTF("Not supported Root vector : 0x%x", static_cast<unsigned>(kRootVector));
@@ -583,6 +645,7 @@ void E131Bridge::CheckMergeTimeouts(uint32_t port_index) {
         output_port_[port_index].source_a.ip = 0;
         memset(output_port_[port_index].source_a.cid, 0, e117::kCidLength);
         output_port_[port_index].is_merging = false;
+        dmxnode::Data::ReleaseMergeSources(port_index);
     }
 
     const auto kTimeOutB = current_millis_ - output_port_[port_index].source_b.millis;
@@ -591,8 +654,13 @@ void E131Bridge::CheckMergeTimeouts(uint32_t port_index) {
         output_port_[port_index].source_b.ip = 0;
         memset(output_port_[port_index].source_b.cid, 0, e117::kCidLength);
         output_port_[port_index].is_merging = false;
+        dmxnode::Data::ReleaseMergeSources(port_index);
     }
 
+    CheckMergeMode();
+}
+
+void E131Bridge::CheckMergeMode() {
     auto is_merging = false;
 
     for (uint32_t i = 0; i < dmxnode::kMaxPorts; i++) {
@@ -605,6 +673,23 @@ void E131Bridge::CheckMergeTimeouts(uint32_t port_index) {
     }
 }
 
+void E131Bridge::ClearSources(uint32_t port_index) {
+    assert(port_index < dmxnode::kMaxPorts);
+
+    auto& output_port = output_port_[port_index];
+
+    output_port.source_a.ip = 0;
+    memset(output_port.source_a.cid, 0, e117::kCidLength);
+    output_port.source_b.ip = 0;
+    memset(output_port.source_b.cid, 0, e117::kCidLength);
+    dmxnode::Data::ReleaseMergeSources(port_index);
+
+    if (output_port.is_merging) {
+        output_port.is_merging = false;
+        CheckMergeMode();
+    }
+}
+
 bool E131Bridge::IsPriorityTimeOut(uint32_t port_index) const {
     assert(port_index < dmxnode::kMaxPorts);
 
@@ -640,189 +725,363 @@ bool E131Bridge::IsIpCidMatch(const e131bridge::Source* const kSource) const {
     return memcmp(kSource->cid, raw.root_layer.cid, e117::kCidLength) == 0;
 }
 
+void E131Bridge::SetSourceA(uint32_t port_index, const uint8_t* data, uint32_t length) {
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+    // A single source can release slots with priority 0
+    const auto& per_address_priority = per_address_priority_[port_index];
+    if (per_address_priority.is_active) {
+        dmxnode::Data::PriorityMergeSourceA(port_index, data, length, per_address_priority.source_a, per_address_priority.source_b);
+        return;
+    }
+#endif
+    dmxnode::Data::SetSourceA(port_index, data, length);
+}
+
+void E131Bridge::SetSourceB(uint32_t port_index, const uint8_t* data, uint32_t length) {
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+    const auto& per_address_priority = per_address_priority_[port_index];
+    if (per_address_priority.is_active) {
+        dmxnode::Data::PriorityMergeSourceB(port_index, data, length, per_address_priority.source_a, per_address_priority.source_b);
+        return;
+    }
+#endif
+    dmxnode::Data::SetSourceB(port_index, data, length);
+}
+
+void E131Bridge::MergeSourceA(uint32_t port_index, const uint8_t* data, uint32_t length) {
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+    const auto& per_address_priority = per_address_priority_[port_index];
+    if (per_address_priority.is_active) {
+        dmxnode::Data::PriorityMergeSourceA(port_index, data, length, per_address_priority.source_a, per_address_priority.source_b);
+        return;
+    }
+#endif
+    dmxnode::Data::MergeSourceA(port_index, data, length, output_port_[port_index].merge_mode);
+}
+
+void E131Bridge::MergeSourceB(uint32_t port_index, const uint8_t* data, uint32_t length) {
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+    const auto& per_address_priority = per_address_priority_[port_index];
+    if (per_address_priority.is_active) {
+        dmxnode::Data::PriorityMergeSourceB(port_index, data, length, per_address_priority.source_a, per_address_priority.source_b);
+        return;
+    }
+#endif
+    dmxnode::Data::MergeSourceB(port_index, data, length, output_port_[port_index].merge_mode);
+}
+
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+void E131Bridge::SetPerAddressPriority(uint32_t port_index, bool is_source_a, bool is_source_b, const uint8_t* priority, uint32_t length) {
+    // Only accepted from a source which is already sending DMX data on this universe
+    if (!(is_source_a || is_source_b)) {
+        return;
+    }
+
+    auto& per_address_priority = per_address_priority_[port_index];
+    auto* destination = is_source_a ? per_address_priority.source_a : per_address_priority.source_b;
+
+    if (length > dmxnode::kUniverseSize) {
+        length = dmxnode::kUniverseSize;
+    }
+
+    memcpy(destination, priority, length);
+    // A priority of 0 means that the source is not sourcing these slots
+    memset(&destination[length], 0, dmxnode::kUniverseSize - length);
+
+    if (is_source_a) {
+        per_address_priority.has_source_a = true;
+        per_address_priority.millis_a = packet_millis_;
+    } else {
+        per_address_priority.has_source_b = true;
+        per_address_priority.millis_b = packet_millis_;
+    }
+}
+
+void E131Bridge::UpdatePerAddressPriority(uint32_t port_index, bool is_source_a, bool is_source_b, uint8_t priority) {
+    auto& per_address_priority = per_address_priority_[port_index];
+    const auto& output_port = output_port_[port_index];
+
+    per_address_priority.has_source_a = per_address_priority.has_source_a && (output_port.source_a.ip != 0) && ((current_millis_ - per_address_priority.millis_a) <= (e131::kPriorityTimeoutSeconds * 1000U));
+    per_address_priority.has_source_b = per_address_priority.has_source_b && (output_port.source_b.ip != 0) && ((current_millis_ - per_address_priority.millis_b) <= (e131::kPriorityTimeoutSeconds * 1000U));
+    per_address_priority.is_active = per_address_priority.has_source_a || per_address_priority.has_source_b;
+
+    if (!per_address_priority.is_active) {
+        return;
+    }
+
+    // A new source takes the same slot as it is assigned in HandleDmx
+    const auto kIsA = is_source_a || (!is_source_b && (output_port.source_a.ip == 0));
+    const auto kIsB = !kIsA && (is_source_b || (output_port.source_b.ip == 0));
+
+    if (kIsA) {
+        per_address_priority.priority_a = priority;
+    } else if (kIsB) {
+        per_address_priority.priority_b = priority;
+    }
+
+    // A source without per-address priority has its universe priority on every slot, a slot without a source has 0
+    if (!per_address_priority.has_source_a) {
+        const auto kIsSourced = kIsA || (output_port.source_a.ip != 0);
+        memset(per_address_priority.source_a, kIsSourced ? per_address_priority.priority_a : 0, dmxnode::kUniverseSize);
+    }
+
+    if (!per_address_priority.has_source_b) {
+        const auto kIsSourced = kIsB || (output_port.source_b.ip != 0);
+        memset(per_address_priority.source_b, kIsSourced ? per_address_priority.priority_b : 0, dmxnode::kUniverseSize);
+    }
+}
+
+/**
+ * Both sources are taken, a third source with a higher universe priority
+ * replaces the source with the lowest one.
+ */
+void E131Bridge::ReplacePerAddressSource(uint32_t port_index, uint8_t priority) {
+    auto& per_address_priority = per_address_priority_[port_index];
+    const auto kIsA = (per_address_priority.priority_a <= per_address_priority.priority_b);
+
+    if (priority <= (kIsA ? per_address_priority.priority_a : per_address_priority.priority_b)) {
+        return;
+    }
+
+    auto& source = kIsA ? output_port_[port_index].source_a : output_port_[port_index].source_b;
+
+    source.ip = 0;
+    memset(source.cid, 0, e117::kCidLength);
+
+    if (kIsA) {
+        per_address_priority.has_source_a = false;
+    } else {
+        per_address_priority.has_source_b = false;
+    }
+}
+#endif
+
 void E131Bridge::HandleDmx() {
     const auto& data = *reinterpret_cast<const e131::DataPacket*>(receive_buffer_);
     const auto* const kDmxData = &data.dmp_layer.property_values[1];
     const auto kDmxSlots = __builtin_bswap16(data.dmp_layer.property_value_count) - 1U;
 
-    for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
-        if (bridge_.port[port_index].direction == dmxnode::Direction::kOutput) {
-            // Frame layer
-            // 8.2 Association of Multicast Addresses and Universe
-            // Note: The identity of the universe shall be determined by the universe number in the
-            // packet and not assumed from the multicast address.
-            if (data.frame_layer.universe != __builtin_bswap16(bridge_.port[port_index].universe)) {
+    // Frame layer
+    // 8.2 Association of Multicast Addresses and Universe
+    // Note: The identity of the universe shall be determined by the universe number in the
+    // packet and not assumed from the multicast address.
+    for (auto port_mask = universe_map_.Find(__builtin_bswap16(data.frame_layer.universe)); port_mask != 0; port_mask &= (port_mask - 1)) {
+        const auto kPortIndex = static_cast<uint32_t>(__builtin_ctz(port_mask));
+
+        auto& source_a = output_port_[kPortIndex].source_a;
+        auto& source_b = output_port_[kPortIndex].source_b;
+
+        auto ip_a = source_a.ip;
+        auto ip_b = source_b.ip;
+
+        auto is_source_a = IsIpCidMatch(&source_a);
+        auto is_source_b = IsIpCidMatch(&source_b);
+
+        // 6.9.2 Sequence Numbering
+        // Having first received a packet with sequence number A, a second packet with sequence number B
+        // arrives. If, using signed 8-bit binary arithmetic, B – A is less than or equal to 0, but greater than -20 then
+        // the packet containing sequence number B shall be deemed out of sequence and discarded
+        if (is_source_a) {
+            const auto kDiff = static_cast<int8_t>(data.frame_layer.sequence_number - source_a.sequence_number_data);
+            source_a.sequence_number_data = data.frame_layer.sequence_number;
+            if ((kDiff <= 0) && (kDiff > -20)) {
+                continue;
+            }
+        } else if (is_source_b) {
+            const auto kDiff = static_cast<int8_t>(data.frame_layer.sequence_number - source_b.sequence_number_data);
+            source_b.sequence_number_data = data.frame_layer.sequence_number;
+            if ((kDiff <= 0) && (kDiff > -20)) {
                 continue;
             }
+        }
 
-            auto& source_a = output_port_[port_index].source_a;
-            auto& source_b = output_port_[port_index].source_b;
+        // This bit, when set to 1, indicates that the data in this packet is intended for use in visualization or media
+        // server preview applications and shall not be used to generate live output.
+        if (e131::OptionsMask::Has(data.frame_layer.options, e131::OptionsMask::Mask::kPreviewData)) {
+            continue;
+        }
 
-            const auto kIpA = source_a.ip;
-            const auto kIpB = source_b.ip;
+        // Upon receipt of a packet containing this bit set to a value of 1, receiver shall enter network data loss condition.
+        // Any property values in these packets shall be ignored.
+        if (e131::OptionsMask::Has(data.frame_layer.options, e131::OptionsMask::Mask::kStreamTerminated)) {
+            if (is_source_a || is_source_b) {
+                SetNetworkDataLossCondition(is_source_a, is_source_b);
+            }
+            continue;
+        }
 
-            const auto kIsSourceA = IsIpCidMatch(&source_a);
-            const auto kIsSourceB = IsIpCidMatch(&source_b);
+        const auto kStartCode = data.dmp_layer.property_values[0];
 
-            // 6.9.2 Sequence Numbering
-            // Having first received a packet with sequence number A, a second packet with sequence number B
-            // arrives. If, using signed 8-bit binary arithmetic, B – A is less than or equal to 0, but greater than -20 then
-            // the packet containing sequence number B shall be deemed out of sequence and discarded
-            if (kIsSourceA) {
-                const auto kDiff = static_cast<int8_t>(data.frame_layer.sequence_number - source_a.sequence_number_data);
-                source_a.sequence_number_data = data.frame_layer.sequence_number;
-                if ((kDiff <= 0) && (kDiff > -20)) {
-                    continue;
-                }
-            } else if (kIsSourceB) {
-                const auto kDiff = static_cast<int8_t>(data.frame_layer.sequence_number - source_b.sequence_number_data);
-                source_b.sequence_number_data = data.frame_layer.sequence_number;
-                if ((kDiff <= 0) && (kDiff > -20)) {
-                    continue;
-                }
-            }
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+        if (kStartCode == e131::startcode::kPerAddressPriority) {
+            SetPerAddressPriority(kPortIndex, is_source_a, is_source_b, kDmxData, kDmxSlots);
+            continue;
+        }
+#endif
 
-            // This bit, when set to 1, indicates that the data in this packet is intended for use in visualization or media
-            // server preview applications and shall not be used to generate live output.
-            if (e131::OptionsMask::Has(data.frame_layer.options, e131::OptionsMask::Mask::kPreviewData)) {
-                continue;
-            }
+        if (kStartCode != e131::startcode::kDmx) {
+            continue;
+        }
 
-            // Upon receipt of a packet containing this bit set to a value of 1, receiver shall enter network data loss condition.
-            // Any property values in these packets shall be ignored.
-            if (e131::OptionsMask::Has(data.frame_layer.options, e131::OptionsMask::Mask::kStreamTerminated)) {
-                if (kIsSourceA || kIsSourceB) {
-                    SetNetworkDataLossCondition(kIsSourceA, kIsSourceB);
-                }
-                continue;
+        if (state_.is_merge_mode) {
+            if (__builtin_expect((!state_.disable_merge_timeout), 1)) {
+                CheckMergeTimeouts(kPortIndex);
             }
+        }
 
-            if (state_.is_merge_mode) {
-                if (__builtin_expect((!state_.disable_merge_timeout), 1)) {
-                    CheckMergeTimeouts(port_index);
-                }
-            }
+        // 6.2.3 Priority is arbitrated per universe, hence per output port.
+        auto& output_port = output_port_[kPortIndex];
+        auto is_per_address_priority = false;
 
-            if (data.frame_layer.priority < state_.priority) {
-                if (!IsPriorityTimeOut(port_index)) {
-                    continue;
-                }
-                state_.priority = data.frame_layer.priority;
-            } else if (data.frame_layer.priority > state_.priority) {
-                output_port_[port_index].source_a.ip = 0;
-                output_port_[port_index].source_b.ip = 0;
-                state_.is_merge_mode = false;
-                state_.priority = data.frame_layer.priority;
-            }
+#if defined(E131_HAVE_PER_ADDRESS_PRIORITY)
+        if (per_address_priority_[kPortIndex].is_active && !is_source_a && !is_source_b && (ip_a != 0) && (ip_b != 0)) {
+            ReplacePerAddressSource(kPortIndex, data.frame_layer.priority);
+            ip_a = source_a.ip;
+            ip_b = source_b.ip;
+        }
+
+        UpdatePerAddressPriority(kPortIndex, is_source_a, is_source_b, data.frame_layer.priority);
+        // The per-slot priorities are arbitrated in the merge
+        is_per_address_priority = per_address_priority_[kPortIndex].is_active;
+#endif
 
-            if ((kIpA == 0) && (kIpB == 0)) {
-                // printf("1. First package from Source\n");
-                source_a.ip = ip_address_from_;
-                source_a.sequence_number_data = data.frame_layer.sequence_number;
-                memcpy(source_a.cid, data.root_layer.cid, 16);
-                source_a.millis = packet_millis_;
-                dmxnode::Data::SetSourceA(port_index, kDmxData, kDmxSlots);
-            } else if (kIsSourceA && (kIpB == 0)) {
-                // printf("2. Continue package from SourceA\n");
-                source_a.sequence_number_data = data.frame_layer.sequence_number;
-                source_a.millis = packet_millis_;
-                dmxnode::Data::SetSourceA(port_index, kDmxData, kDmxSlots);
-            } else if ((kIpA == 0) && kIsSourceB) {
-                // printf("3. Continue package from source_b\n");
-                source_b.sequence_number_data = data.frame_layer.sequence_number;
-                source_b.millis = packet_millis_;
-                dmxnode::Data::SetSourceB(port_index, kDmxData, kDmxSlots);
-            } else if (!kIsSourceA && (kIpB == 0)) {
-                // printf("4. New ip, start merging\n");
-                source_b.ip = ip_address_from_;
-                source_b.sequence_number_data = data.frame_layer.sequence_number;
-                memcpy(source_b.cid, data.root_layer.cid, 16);
-                source_b.millis = packet_millis_;
-                UpdateMergeStatus(port_index);
-                dmxnode::Data::MergeSourceB(port_index, kDmxData, kDmxSlots, output_port_[port_index].merge_mode);
-            } else if ((kIpA == 0) && !kIsSourceB) {
-                // printf("5. New ip, start merging\n");
-                source_a.ip = ip_address_from_;
-                source_a.sequence_number_data = data.frame_layer.sequence_number;
-                memcpy(source_a.cid, data.root_layer.cid, 16);
-                source_a.millis = packet_millis_;
-                UpdateMergeStatus(port_index);
-                dmxnode::Data::MergeSourceA(port_index, kDmxData, kDmxSlots, output_port_[port_index].merge_mode);
-            } else if (kIsSourceA && !kIsSourceB) {
-                // printf("6. Continue merging\n");
-                source_a.sequence_number_data = data.frame_layer.sequence_number;
-                source_a.millis = packet_millis_;
-                UpdateMergeStatus(port_index);
-                dmxnode::Data::MergeSourceA(port_index, kDmxData, kDmxSlots, output_port_[port_index].merge_mode);
-            } else if (!kIsSourceA && kIsSourceB) {
-                // printf("7. Continue merging\n");
-                source_b.sequence_number_data = data.frame_layer.sequence_number;
-                source_b.millis = packet_millis_;
-                UpdateMergeStatus(port_index);
-                dmxnode::Data::MergeSourceB(port_index, kDmxData, kDmxSlots, output_port_[port_index].merge_mode);
+        if (is_per_address_priority) {
+            if (data.frame_layer.priority > output_port.priority) {
+                output_port.priority = data.frame_layer.priority;
             }
-#ifndef NDEBUG
-            else if (kIsSourceA && kIsSourceB) {
-                puts("WARN: 8. Source matches both ip, discarding data");
-                return;
-            } else if (!kIsSourceA && !kIsSourceB) {
-                puts("WARN: 9. More than two sources, discarding data");
-                return;
-            } else {
-                puts("ERROR: 0. No cases matched, this shouldn't happen!");
-                return;
+        } else if (data.frame_layer.priority < output_port.priority) {
+            if (!IsPriorityTimeOut(kPortIndex)) {
+                continue;
             }
+            output_port.priority = data.frame_layer.priority;
+        } else if (data.frame_layer.priority > output_port.priority) {
+            // The higher priority source takes over this universe only
+            ClearSources(kPortIndex);
+            output_port.priority = data.frame_layer.priority;
+
+            ip_a = 0;
+            ip_b = 0;
+            is_source_a = false;
+            is_source_b = false;
+        }
+
+        if ((ip_a == 0) && (ip_b == 0)) {
+            // printf("1. First package from Source\n");
+            source_a.ip = ip_address_from_;
+            source_a.sequence_number_data = data.frame_layer.sequence_number;
+            memcpy(source_a.cid, data.root_layer.cid, 16);
+            source_a.millis = packet_millis_;
+            SetSourceA(kPortIndex, kDmxData, kDmxSlots);
+        } else if (is_source_a && (ip_b == 0)) {
+            // printf("2. Continue package from SourceA\n");
+            source_a.sequence_number_data = data.frame_layer.sequence_number;
+            source_a.millis = packet_millis_;
+            SetSourceA(kPortIndex, kDmxData, kDmxSlots);
+        } else if ((ip_a == 0) && is_source_b) {
+            // printf("3. Continue package from source_b\n");
+            source_b.sequence_number_data = data.frame_layer.sequence_number;
+            source_b.millis = packet_millis_;
+            SetSourceB(kPortIndex, kDmxData, kDmxSlots);
+        } else if (!is_source_a && (ip_b == 0)) {
+            // printf("4. New ip, start merging\n");
+            source_b.ip = ip_address_from_;
+            source_b.sequence_number_data = data.frame_layer.sequence_number;
+            memcpy(source_b.cid, data.root_layer.cid, 16);
+            source_b.millis = packet_millis_;
+            UpdateMergeStatus(kPortIndex);
+            MergeSourceB(kPortIndex, kDmxData, kDmxSlots);
+        } else if ((ip_a == 0) && !is_source_b) {
+            // printf("5. New ip, start merging\n");
+            source_a.ip = ip_address_from_;
+            source_a.sequence_number_data = data.frame_layer.sequence_number;
+            memcpy(source_a.cid, data.root_layer.cid, 16);
+            source_a.millis = packet_millis_;
+            UpdateMergeStatus(kPortIndex);
+            MergeSourceA(kPortIndex, kDmxData, kDmxSlots);
+        } else if (is_source_a && !is_source_b) {
+            // printf("6. Continue merging\n");
+            source_a.sequence_number_data = data.frame_layer.sequence_number;
+            source_a.millis = packet_millis_;
+            UpdateMergeStatus(kPortIndex);
+            MergeSourceA(kPortIndex, kDmxData, kDmxSlots);
+        } else if (!is_source_a && is_source_b) {
+            // printf("7. Continue merging\n");
+            source_b.sequence_number_data = data.frame_layer.sequence_number;
+            source_b.millis = packet_millis_;
+            UpdateMergeStatus(kPortIndex);
+            MergeSourceB(kPortIndex, kDmxData, kDmxSlots);
+        }
+#ifndef NDEBUG
+        else if (is_source_a && is_source_b) {
+            puts("WARN: 8. Source matches both ip, discarding data");
+            return;
+        } else if (!is_source_a && !is_source_b) {
+            puts("WARN: 9. More than two sources, discarding data");
+            return;
+        } else {
+            puts("ERROR: 0. No cases matched, this shouldn't happen!");
+            return;
+        }
 #endif
-            // This bit indicates whether to lock or revert to an unsynchronized state when synchronization is lost
-            // (See Section 11 on Universe Synchronization and 11.1 for discussion on synchronization states).
-            // When set to 0, components that had been operating in a synchronized state shall not update with any
-            // new packets until synchronization resumes. When set to 1, once synchronization has been lost,
-            // components that had been operating in a synchronized state need not wait for a new
-            // E1.31 Synchronization Packet in order to update to the next E1.31 Data Packet.
-
-            // If the FORCE_SYNCHRONIZATION bit is 0, the receiver MUST wait for synchronization packets.
-            // If it is 1, the receiver MAY update without waiting for synchronization packets.
-            if (!e131::OptionsMask::Has(data.frame_layer.options, e131::OptionsMask::Mask::kForceSynchronization)) {
-                // 6.3.3.1 Synchronization Address Usage in an E1.31 Synchronization Packet
-                // An E1.31 Synchronization Packet is sent to synchronize the E1.31 data on a specific universe number.
-                // A Synchronization Address of 0 is thus meaningless, and shall not be transmitted.
-                // Receivers shall ignore E1.31 Synchronization Packets containing a Synchronization Address of 0.
-
-                // Synchronization is required: enter synchronized state (until sync is lost or overridden)
-                if (data.frame_layer.synchronization_address != 0) {
-                    if (!state_.is_forced_synchronized) {
-                        // Decide which source triggered the sync request
-                        if (!(kIsSourceA || kIsSourceB)) {
-                            SetSynchronizationAddress((source_a.ip != 0), (source_b.ip != 0), __builtin_bswap16(data.frame_layer.synchronization_address));
-                        } else {
-                            SetSynchronizationAddress(kIsSourceA, kIsSourceB, __builtin_bswap16(data.frame_layer.synchronization_address));
-                        }
-                        state_.is_forced_synchronized = true;
-                        state_.is_synchronized = true;
+        const auto kSynchronizationAddress = __builtin_bswap16(data.frame_layer.synchronization_address);
+
+        if (output_port.synchronization_address != kSynchronizationAddress) {
+            output_port.synchronization_address = kSynchronizationAddress;
+            UpdateSynchronizationMap();
+        }
+
+        // This bit indicates whether to lock or revert to an unsynchronized state when synchronization is lost
+        // (See Section 11 on Universe Synchronization and 11.1 for discussion on synchronization states).
+        // When set to 0, components that had been operating in a synchronized state shall not update with any
+        // new packets until synchronization resumes. When set to 1, once synchronization has been lost,
+        // components that had been operating in a synchronized state need not wait for a new
+        // E1.31 Synchronization Packet in order to update to the next E1.31 Data Packet.
+
+        // If the FORCE_SYNCHRONIZATION bit is 0, the receiver MUST wait for synchronization packets.
+        // If it is 1, the receiver MAY update without waiting for synchronization packets.
+        if (!e131::OptionsMask::Has(data.frame_layer.options, e131::OptionsMask::Mask::kForceSynchronization)) {
+            // 6.3.3.1 Synchronization Address Usage in an E1.31 Synchronization Packet
+            // An E1.31 Synchronization Packet is sent to synchronize the E1.31 data on a specific universe number.
+            // A Synchronization Address of 0 is thus meaningless, and shall not be transmitted.
+            // Receivers shall ignore E1.31 Synchronization Packets containing a Synchronization Address of 0.
+
+            // Synchronization is required: enter synchronized state (until sync is lost or overridden)
+            if (data.frame_layer.synchronization_address != 0) {
+                if (!state_.is_forced_synchronized) {
+                    // Decide which source triggered the sync request
+                    if (!(is_source_a || is_source_b)) {
+                        SetSynchronizationAddress((source_a.ip != 0), (source_b.ip != 0), kSynchronizationAddress);
+                    } else {
+                        SetSynchronizationAddress(is_source_a, is_source_b, kSynchronizationAddress);
                     }
+                    state_.is_forced_synchronized = true;
+                    state_.is_synchronized = true;
                 }
-            } else {
-                // Synchronization not required — allow unsynchronized updates
-                state_.is_forced_synchronized = false;
             }
+        } else {
+            // Synchronization not required — allow unsynchronized updates
+            state_.is_forced_synchronized = false;
+        }
 
-            const auto kDoUpdate = ((!state_.is_synchronized) || (state_.disable_synchronize));
+        const auto kDoUpdate = ((!state_.is_synchronized) || (state_.disable_synchronize));
 
-            if (kDoUpdate) {
-                dmxnode::DataOutput(dmxnode_output_type_, port_index);
+        if (kDoUpdate) {
+            dmxnode::DataOutput(dmxnode_output_type_, kPortIndex);
 
-                if (!output_port_[port_index].is_transmitting) {
-                    dmxnode_output_type_->Start(port_index);
-                    output_port_[port_index].is_transmitting = true;
-                    state_.is_changed = true;
-                }
-            } else {
-                dmxnode::DataSet(dmxnode_output_type_, port_index);
-                output_port_[port_index].is_data_pending = true;
+            if (!output_port_[kPortIndex].is_transmitting) {
+                dmxnode_output_type_->Start(kPortIndex);
+                output_port_[kPortIndex].is_transmitting = true;
+                state_.is_changed = true;
             }
+        } else {
+            dmxnode::DataSet(dmxnode_output_type_, kPortIndex);
 
-            state_.receiving_dmx |= (1U << static_cast<uint8_t>(dmxnode::Direction::kOutput));
+            for (auto port_mask = dmxnode::OutputPortMask(1U << kPortIndex); port_mask != 0; port_mask &= (port_mask - 1)) {
+                output_port_[__builtin_ctz(port_mask)].is_data_pending = true;
+            }
         }
+
+        state_.receiving_dmx |= (1U << static_cast<uint8_t>(dmxnode::Direction::kOutput));
     }
 }
 
@@ -838,7 +1097,6 @@ void E131Bridge::SetNetworkDataLossCondition(bool source_a, bool source_b) {
         state_.is_merge_mode = false;
         state_.is_synchronized = false;
         state_.is_forced_synchronized = false;
-        state_.priority = e131::priority::kLowest;
 
         for (uint32_t i = 0; i < dmxnode::kMaxPorts; i++) {
             if (output_port_[i].is_transmitting) {
@@ -847,7 +1105,9 @@ void E131Bridge::SetNetworkDataLossCondition(bool source_a, bool source_b) {
                 memset(output_port_[i].source_a.cid, 0, e117::kCidLength);
                 output_port_[i].source_b.ip = 0;
                 memset(output_port_[i].source_b.cid, 0, e117::kCidLength);
+                output_port_[i].priority = e131::priority::kLowest;
                 dmxnode::Data::ClearLength(i);
+                dmxnode::Data::ReleaseMergeSources(i);
                 output_port_[i].is_transmitting = false;
                 output_port_[i].is_merging = false;
             }
@@ -859,12 +1119,18 @@ void E131Bridge::SetNetworkDataLossCondition(bool source_a, bool source_b) {
                     output_port_[i].source_a.ip = 0;
                     memset(output_port_[i].source_a.cid, 0, e117::kCidLength);
                     output_port_[i].is_merging = false;
+                    dmxnode::Data::ReleaseMergeSources(i);
                 }
 
                 if ((source_b) && (output_port_[i].source_b.ip != 0)) {
                     output_port_[i].source_b.ip = 0;
                     memset(output_port_[i].source_b.cid, 0, e117::kCidLength);
                     output_port_[i].is_merging = false;
+                    dmxnode::Data::ReleaseMergeSources(i);
+                }
+
+                if ((output_port_[i].source_a.ip == 0) && (output_port_[i].source_b.ip == 0)) {
+                    output_port_[i].priority = e131::priority::kLowest;
                 }
 
                 if (!state_.is_merge_mode) {
@@ -39,6 +39,11 @@ inline constexpr uint8_t kMode3 = 3; ///< CPOL = 1, CPHA = 1
 inline constexpr uint8_t kCs = 0;     ///< Chip Select
 inline constexpr uint8_t kCsNone = 1; ///< No CS, control it yourself
 
+/**
+ * The device that Begin opens, default /dev/spidev0.0. When it is not a spidev,
+ * for example a regular file or a FIFO, the data is written to it as is.
+ */
+void SetDevice(const char* device);
 void Begin();
 void SetSpeedHz(uint32_t speed_hz);
 void SetDataMode(uint8_t mode);
@@ -46,6 +51,15 @@ void ChipSelect(uint8_t chip_select);
 void Transfern(char* tx_buffer, uint32_t length);
 void Write(uint16_t data);
 void Writenb(const char* data, uint32_t length);
+
+/**
+ * The equivalent of the H3 SPI TX DMA: the transfer is done by an output thread.
+ * A frame is sent as one SPI_IOC_MESSAGE of transfers of at most the spidev
+ * buffer size. When spidev rejects the message as too large, the transfers are sent one by one.
+ */
+const uint8_t* DmaTxPrepare(uint32_t* data_length);
+void DmaTxStart(const uint8_t* tx_buffer, uint32_t length);
+bool DmaTxIsActive();
 } // namespace spi
 
 class Spi {
@@ -23,8 +23,14 @@
  * THE SOFTWARE.
  */
 
+#include <cstdint>
 #include <cstdio>
+#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #if defined(__linux__)
+#include <cerrno>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
@@ -36,9 +42,20 @@
 namespace spi {
 #if defined(__linux__)
 static constexpr char kDevice[] = "/dev/spidev0.0";
+static constexpr char kBufsiz[] = "/sys/module/spidev/parameters/bufsiz";
+static const char* s_device = kDevice;
+static bool s_is_spidev = true;
+static uint32_t s_bufsiz = 4096; ///< The maximum length of a spidev message
 int file = -1;
 #endif
 
+void SetDevice([[maybe_unused]] const char* device) {
+#if defined(__linux__)
+    assert(device != nullptr);
+    s_device = device;
+#endif
+}
+
 void Begin() {
 #if defined(__linux__)
     if (file != -1) {
@@ -46,18 +63,46 @@ void Begin() {
         file = -1;
     }
 
-    file = open(kDevice, O_RDWR | O_CLOEXEC);
+    file = open(s_device, O_RDWR | O_CLOEXEC);
     if (file < 0) {
-        perror(kDevice);
+        perror(s_device);
         return;
     }
 
     uint8_t bits = 8;
 
     if (ioctl(file, SPI_IOC_WR_BITS_PER_WORD, &bits) == -1) {
+        if (errno == ENOTTY) {
+            s_is_spidev = false;
+            printf("spi::Begin: %s is not a spidev\n", s_device);
+            return;
+        }
+
         perror("SPI_IOC_WR_BITS_PER_WORD");
         close(file);
         file = -1;
+        return;
+    }
+
+    s_is_spidev = true;
+
+    auto* fp = fopen(kBufsiz, "r");
+
+    if (fp != nullptr) {
+        unsigned bufsiz;
+
+        if ((fscanf(fp, "%u", &bufsiz) == 1) && (bufsiz != 0)) {
+            s_bufsiz = bufsiz;
+        }
+
+        fclose(fp);
+    }
+
+    static bool s_warned;
+
+    if (!s_warned) {
+        s_warned = true;
+        printf("spi::Begin: spidev.bufsiz=%u must be at least the frame size, else the frame is sent in parts\n", static_cast<unsigned>(s_bufsiz));
     }
 #else
     puts("spi::Begin");
@@ -66,7 +111,7 @@ void Begin() {
 
 void SetSpeedHz(uint32_t speed_hz) {
 #if defined(__linux__)
-    if (file < 0) [[unlikely]] {
+    if ((file < 0) || !s_is_spidev) [[unlikely]] {
         return;
     }
 
@@ -80,7 +125,7 @@ void SetSpeedHz(uint32_t speed_hz) {
 
 void SetDataMode([[maybe_unused]] uint8_t mode) {
 #if defined(__linux__)
-    if (file < 0) [[unlikely]] {
+    if ((file < 0) || !s_is_spidev) [[unlikely]] {
         return;
     }
 
@@ -106,6 +151,13 @@ void Transfern(char* tx_buffer, uint32_t length) {
         return;
     }
 
+    if (!s_is_spidev) {
+        if (write(file, tx_buffer, length) < 0) {
+            perror("Transfern");
+        }
+        return;
+    }
+
     struct spi_ioc_transfer tr{};
 
     tr.tx_buf = reinterpret_cast<unsigned long>(tx_buffer);
@@ -136,4 +188,103 @@ void Writenb(const char* data, uint32_t length) {
     printf("spi::Writenb=%p:%u\n", reinterpret_cast<const void*>(data), length);
 #endif
 }
-} // namespace spi
\ No newline at end of file
+
+namespace dma {
+static uint8_t s_tx_buffer[128 * 1024] __attribute__((aligned(4)));
+static constexpr uint32_t kStop = UINT32_MAX;
+static const uint8_t* s_data;
+/**
+ * Not 0 while a transfer is active, kStop ends the output thread
+ */
+static std::atomic<uint32_t> s_length;
+
+static void Send([[maybe_unused]] const uint8_t* data, [[maybe_unused]] uint32_t length) {
+#if defined(__linux__)
+    if (file < 0) [[unlikely]] {
+        return;
+    }
+
+    if (!s_is_spidev) {
+        if (write(file, data, length) < 0) {
+            perror("spi::dma::Send");
+        }
+        return;
+    }
+
+    // spidev rejects a message that is longer than spidev.bufsiz, a larger frame is sent in parts
+    for (uint32_t offset = 0; offset < length; offset += s_bufsiz) {
+        struct spi_ioc_transfer tr = {};
+
+        tr.tx_buf = reinterpret_cast<uintptr_t>(&data[offset]);
+        tr.len = std::min(length - offset, s_bufsiz);
+
+        if (ioctl(file, SPI_IOC_MESSAGE(1), &tr) < 0) {
+            perror("spi::dma::Send");
+            return;
+        }
+    }
+#endif
+}
+
+static void Thread() {
+    for (;;) {
+        s_length.wait(0, std::memory_order_acquire);
+
+        const auto kLength = s_length.load(std::memory_order_relaxed);
+
+        if (kLength == kStop) {
+            return;
+        }
+
+        Send(s_data, kLength);
+
+        s_length.store(0, std::memory_order_release);
+    }
+}
+
+/**
+ * The output thread is started once and joined at exit, after the last frame is sent
+ */
+class Worker {
+   public:
+    Worker() : thread_(Thread) {}
+
+    ~Worker() {
+        while (DmaTxIsActive()) {
+            std::this_thread::yield();
+        }
+
+        s_length.store(kStop, std::memory_order_release);
+        s_length.notify_one();
+        thread_.join();
+        s_length.store(0, std::memory_order_relaxed);
+    }
+
+   private:
+    std::thread thread_;
+};
+} // namespace dma
+
+const uint8_t* DmaTxPrepare(uint32_t* data_length) {
+    assert(data_length != nullptr);
+
+    static dma::Worker s_worker;
+
+    *data_length = sizeof(dma::s_tx_buffer);
+    return dma::s_tx_buffer;
+}
+
+void DmaTxStart(const uint8_t* tx_buffer, uint32_t length) {
+    assert(!DmaTxIsActive());
+    assert(tx_buffer != nullptr);
+    assert(length != 0);
+
+    dma::s_data = tx_buffer;
+    dma::s_length.store(length, std::memory_order_release);
+    dma::s_length.notify_one();
+}
+
+bool DmaTxIsActive() {
+    return dma::s_length.load(std::memory_order_acquire) != 0;
+}
+} // namespace spi
@@ -31,11 +31,19 @@
 namespace network::udp {
 typedef void (*UdpCallbackFunctionPtr)(const uint8_t*, uint32_t, uint32_t, uint16_t);
 
+struct Message {
+    const uint8_t* data;
+    uint32_t size;
+    uint32_t remote_ip;
+    uint16_t remote_port;
+};
+
 int32_t Begin(uint16_t, UdpCallbackFunctionPtr callback);
 int32_t End(uint16_t);
 uint32_t Recv(const int32_t, const uint8_t**, uint32_t*, uint16_t*);
 void Send(int32_t, const uint8_t*, uint32_t, uint32_t, uint16_t);
 void SendWithTimestamp(int32_t, const uint8_t*, uint32_t, uint32_t, uint16_t);
+void SendBatch(int32_t, const Message*, uint32_t);
 } // namespace network::udp
 
 #endif // NETWORK_UDP_H_
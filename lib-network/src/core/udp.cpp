@@ -262,6 +262,13 @@ void Send(int32_t index, const uint8_t* data, uint32_t size, uint32_t remote_ip,
     SendImplementation<network::arp::EthSend::kIsNormal>(index, data, size, remote_ip, remote_port);
 }
 
+void SendBatch(int32_t index, const Message* messages, uint32_t count) {
+    // The Ethernet DMA descriptor ring queues the frames, the CPU only builds the headers
+    for (uint32_t i = 0; i < count; i++) {
+        SendImplementation<network::arp::EthSend::kIsNormal>(index, messages[i].data, messages[i].size, messages[i].remote_ip, messages[i].remote_port);
+    }
+}
+
 #if defined CONFIG_NET_ENABLE_PTP
 void SendWithTimestamp(int32_t index, const uint8_t* data, uint32_t size, uint32_t remote_ip, uint16_t remote_port) {
     SendImplementation<network::arp::EthSend::kIsTimestamp>(index, data, size, remote_ip, remote_port);
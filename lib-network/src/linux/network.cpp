@@ -33,7 +33,9 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <cstring>
+#include <algorithm>
 #include <arpa/inet.h>
+#include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <sys/types.h>
 #include <net/if.h>
@@ -413,6 +415,56 @@ void Send(int32_t handle, const uint8_t* pPacket, uint32_t nSize, uint32_t nToIp
         perror("sendto");
     }
 }
+
+void SendBatch(int32_t handle, const Message* messages, uint32_t count) {
+#if defined(__linux__)
+    // One system call for a whole chunk of datagrams
+    static constexpr uint32_t kChunk = 64;
+    struct mmsghdr headers[kChunk];
+    struct iovec iov[kChunk];
+    struct sockaddr_in si_other[kChunk];
+
+    while (count != 0) {
+        const auto kCount = std::min(count, kChunk);
+
+        memset(headers, 0, kCount * sizeof(headers[0]));
+
+        for (uint32_t i = 0; i < kCount; i++) {
+            si_other[i].sin_family = AF_INET;
+            si_other[i].sin_addr.s_addr = messages[i].remote_ip;
+            si_other[i].sin_port = htons(messages[i].remote_port);
+
+            iov[i].iov_base = const_cast<uint8_t*>(messages[i].data);
+            iov[i].iov_len = messages[i].size;
+
+            headers[i].msg_hdr.msg_name = &si_other[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(si_other[i]);
+            headers[i].msg_hdr.msg_iov = &iov[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        uint32_t sent = 0;
+
+        while (sent < kCount) {
+            const auto kResult = sendmmsg(handle, &headers[sent], kCount - sent, 0);
+
+            if (kResult == -1) {
+                perror("sendmmsg");
+                break;
+            }
+
+            sent += static_cast<uint32_t>(kResult);
+        }
+
+        messages += kCount;
+        count -= kCount;
+    }
+#else
+    for (uint32_t i = 0; i < count; i++) {
+        Send(handle, messages[i].data, messages[i].size, messages[i].remote_ip, messages[i].remote_port);
+    }
+#endif
+}
 } // namespace udp
 
 namespace tcp {
@@ -29,6 +29,7 @@
 #include <cstdint>
 
 #include "dmxnode.h"
+#include "dmxnodedata.h"
 
 class PCA9685DmxSet {
    public:
@@ -54,6 +55,19 @@ class PCA9685DmxSet {
 
     template <bool doUpdate> void SetData(uint32_t port_index, const uint8_t* data, uint32_t length) { SetDataImpl(port_index, data, length); }
 
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+    static constexpr bool kHasDirtySlots = true;
+
+    /**
+     * The I2C bus is only used when a slot within the footprint changed
+     */
+    template <bool doUpdate> void SetData(uint32_t port_index, const uint8_t* data, uint32_t length, const dmxnode::DirtySlots& dirty) {
+        if (dirty.IsDirty(GetDmxStartAddress() - 1U, GetDmxFootprint())) {
+            SetDataImpl(port_index, data, length);
+        }
+    }
+#endif
+
     uint32_t GetUserData() { return 0; }    ///< Art-Net ArtPollReply
     uint32_t GetRefreshRate() { return 0; } ///< Art-Net ArtPollReply
 
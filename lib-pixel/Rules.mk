@@ -4,4 +4,6 @@ EXTRA_SRCDIR+=src/json
 ifneq ($(MAKE_FLAGS),)
 else
 	DEFINES+=OUTPUT_DMX_PIXEL_MULTI PIXELPATTERNS_MULTI
+	DEFINES+=CONFIG_PIXELDMX_ENABLE_DITHER
+	DEFINES+=CONFIG_PIXELDMX_ENABLE_GOVERNOR
 endif
\ No newline at end of file
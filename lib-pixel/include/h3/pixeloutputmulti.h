@@ -42,6 +42,9 @@
 #include <cstdint>
 
 #include "pixeltype.h"
+#include "pixelconfiguration.h"
+#include "pixelcolourmatrix.h"
+#include "pixeldither.h"
 #include "h3_spi.h"
 #include "h3.h"
 
@@ -57,147 +60,250 @@ class PixelOutputMulti final
 
     inline void SetColourRTZ(uint32_t port_index, uint32_t pixel_index, uint8_t colour1, uint8_t colour2, uint8_t colour3)
     {
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        SetLevels(port_index, pixel_index, static_cast<uint16_t>(colour1 * 257U), static_cast<uint16_t>(colour2 * 257U), static_cast<uint16_t>(colour3 * 257U));
+#else
         SetColour(port_index, pixel_index, colour1, colour2, colour3);
+#endif
     }
 
-#define BIT_SET(a, b) ((a) |= static_cast<uint8_t>((1 << (b))))
-#define BIT_CLEAR(a, b) ((a) &= static_cast<uint8_t>(~(1 << (b))))
-
     inline void SetColourRTZ(uint32_t port_index, uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
     {
-        uint32_t local_buffer[32] __attribute__((aligned(32)));
-        const auto kPixelIndex = pixel_index * pixel::single::kRgbw;
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        SetLevels(port_index, pixel_index, static_cast<uint16_t>(red * 257U), static_cast<uint16_t>(green * 257U), static_cast<uint16_t>(blue * 257U), static_cast<uint16_t>(white * 257U));
+#else
+        SetPixel4Bytes(port_index, pixel_index, red, green, blue, white);
+#endif
+    }
+
+    inline void SetColourWS2801(uint32_t port_index, uint32_t pixel_index, uint8_t colour1, uint8_t colour2, uint8_t colour3)
+    {
+        SetColour(port_index, pixel_index, colour1, colour2, colour3);
+    }
+
+    inline void SetPixel4Bytes(uint32_t port_index, uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
+    {
+        auto* const staging = &staging_[(pixel_index * 4) * 8 + port_index];
 
-        for (uint32_t i = 0; i < 32; i++)
+        // GRBW
+        staging[0] = green;
+        staging[8] = red;
+        staging[16] = blue;
+        staging[24] = white;
+
+        port_mask_ |= static_cast<uint8_t>(1U << port_index);
+    }
+
+    /**
+     * Writes count pixels of a port from consecutive DMX slots, kMap gives the slots of the colours.
+     */
+    template <pixel::LedFamily kFamily, uint32_t kMap> void SetPixels(uint32_t port_index, uint32_t first_pixel, const uint8_t* dmx, uint32_t count)
+    {
+        if ((matrix_mask_ & (1U << port_index)) != 0)
         {
-            local_buffer[i] = kPixelDatabuffer[kPixelIndex + i];
+            SetPixelsMatrix<kFamily, kMap>(port_index, first_pixel, dmx, count);
+            return;
         }
 
-        uint32_t j = 0;
-
-        for (uint8_t mask = 0x80; mask != 0; mask = static_cast<uint8_t>(mask >> 1))
+        if constexpr (kFamily == pixel::LedFamily::kRtzRgbw)
         {
-            // GRBW
-            if (mask & green)
-            {
-                BIT_SET(local_buffer[j], port_index);
-            }
-            else
+            for (uint32_t i = 0; i < count; i++)
             {
-                BIT_CLEAR(local_buffer[j], port_index);
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+                SetLevels(port_index, first_pixel + i, gamma16_[dmx[0]], gamma16_[dmx[1]], gamma16_[dmx[2]], gamma16_[dmx[3]]);
+#else
+                SetColourRTZ(port_index, first_pixel + i, dmx[0], dmx[1], dmx[2], dmx[3]);
+#endif
+                dmx += 4;
             }
+        }
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        else if constexpr (kFamily == pixel::LedFamily::kRtz)
+        {
+            // The gamma is applied in 16 bits, the dithering gives the steps in between
+            constexpr auto& kChannels = pixel::kMapChannels[kMap];
 
-            if (mask & red)
+            for (uint32_t i = 0; i < count; i++)
             {
-                BIT_SET(local_buffer[8 + j], port_index);
-            }
-            else
-            {
-                BIT_CLEAR(local_buffer[8 + j], port_index);
+                SetLevels(port_index, first_pixel + i, gamma16_[dmx[kChannels[0]]], gamma16_[dmx[kChannels[1]]], gamma16_[dmx[kChannels[2]]]);
+                dmx += 3;
             }
+        }
+#endif
+        else
+        {
+            constexpr auto& kChannels = pixel::kMapChannels[kMap];
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+            const auto* const kGammaTable = PixelConfiguration::Get().GetGammaTable();
+#endif
+            [[maybe_unused]] const auto kGlobalBrightness = PixelConfiguration::Get().GetGlobalBrightness();
 
-            if (mask & blue)
-            {
-                BIT_SET(local_buffer[16 + j], port_index);
-            }
-            else
+            for (uint32_t i = 0; i < count; i++)
             {
-                BIT_CLEAR(local_buffer[16 + j], port_index);
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+                const auto kColour1 = kGammaTable[dmx[kChannels[0]]];
+                const auto kColour2 = kGammaTable[dmx[kChannels[1]]];
+                const auto kColour3 = kGammaTable[dmx[kChannels[2]]];
+#else
+                const auto kColour1 = dmx[kChannels[0]];
+                const auto kColour2 = dmx[kChannels[1]];
+                const auto kColour3 = dmx[kChannels[2]];
+#endif
+                if constexpr ((kFamily == pixel::LedFamily::kRtz) || (kFamily == pixel::LedFamily::kWS2801))
+                {
+                    SetColour(port_index, first_pixel + i, kColour1, kColour2, kColour3);
+                }
+                else if constexpr (kFamily == pixel::LedFamily::kAPA102)
+                {
+                    SetPixel4Bytes(port_index, 1 + first_pixel + i, kGlobalBrightness, kColour3, kColour2, kColour1);
+                }
+                else
+                {
+                    static_assert(kFamily == pixel::LedFamily::kP9813);
+                    const auto kFlag = static_cast<uint8_t>(0xC0 | ((~kColour3 & 0xC0) >> 2) | ((~kColour2 & 0xC0) >> 4) | ((~kColour1 & 0xC0) >> 6));
+                    SetPixel4Bytes(port_index, 1 + first_pixel + i, kFlag, kColour3, kColour2, kColour1);
+                }
+
+                dmx += 3;
             }
+        }
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    /**
+     * RTZ only: as SetPixels, with a 16-bit colour from 2 slots, coarse first.
+     * The level is used as is, without gamma.
+     */
+    template <pixel::LedFamily kFamily, uint32_t kMap> void SetPixels16(uint32_t port_index, uint32_t first_pixel, const uint8_t* dmx, uint32_t count)
+    {
+        static_assert((kFamily == pixel::LedFamily::kRtz) || (kFamily == pixel::LedFamily::kRtzRgbw));
+
+        const auto kLevel = [dmx](uint32_t slot) { return static_cast<uint16_t>((dmx[slot * 2] << 8) | dmx[slot * 2 + 1]); };
 
-            if (mask & white)
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if constexpr (kFamily == pixel::LedFamily::kRtzRgbw)
             {
-                BIT_SET(local_buffer[24 + j], port_index);
+                SetLevels(port_index, first_pixel + i, kLevel(0), kLevel(1), kLevel(2), kLevel(3));
+                dmx += 8;
             }
             else
             {
-                BIT_CLEAR(local_buffer[24 + j], port_index);
+                constexpr auto& kChannels = pixel::kMapChannels[kMap];
+                SetLevels(port_index, first_pixel + i, kLevel(kChannels[0]), kLevel(kChannels[1]), kLevel(kChannels[2]));
+                dmx += 6;
             }
-
-            j++;
-        }
-
-        // Write back to m_pBuffer1
-        for (uint32_t i = 0; i < 32; i++)
-        {
-            kPixelDatabuffer[kPixelIndex + i] = local_buffer[i];
         }
     }
 
-    inline void SetColourWS2801(uint32_t port_index, uint32_t pixel_index, uint8_t colour1, uint8_t colour2, uint8_t colour3)
+    /**
+     * RTZ only: as SetPixels, with an 8.8 DMX value from 2 slots, integer part first.
+     * The gamma is interpolated between the 2 values, the dithering gives the fraction.
+     * A port with a colour matrix gets the rounded value.
+     */
+    template <pixel::LedFamily kFamily, uint32_t kMap> void SetPixelsBlend(uint32_t port_index, uint32_t first_pixel, const uint8_t* dmx, uint32_t count)
     {
-        SetColour(port_index, pixel_index, colour1, colour2, colour3);
-    }
+        static_assert((kFamily == pixel::LedFamily::kRtz) || (kFamily == pixel::LedFamily::kRtzRgbw));
+        constexpr uint32_t kSlots = (kFamily == pixel::LedFamily::kRtzRgbw) ? 4 : 3;
 
-    inline void SetPixel4Bytes(uint32_t port_index, uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white)
-    {
-        uint32_t local_buffer[32] __attribute__((aligned(32)));
-        const auto kPixelIndex = pixel_index * pixel::single::kRgbw;
-
-        for (uint32_t i = 0; i < 32; i++)
+        if ((matrix_mask_ & (1U << port_index)) != 0)
         {
-            local_buffer[i] = kPixelDatabuffer[kPixelIndex + i];
+            for (uint32_t i = 0; i < count; i++)
+            {
+                uint8_t rounded[kSlots];
+
+                for (uint32_t slot = 0; slot < kSlots; slot++)
+                {
+                    rounded[slot] = static_cast<uint8_t>(dmx[slot * 2] + (dmx[slot * 2 + 1] >> 7));
+                }
+
+                SetPixelsMatrix<kFamily, kMap>(port_index, first_pixel + i, rounded, 1);
+                dmx += kSlots * 2;
+            }
+            return;
         }
 
-        uint32_t j = 0;
+        const auto kLevel = [this, dmx](uint32_t slot) { return Gamma16(dmx[slot * 2], dmx[slot * 2 + 1]); };
 
-        for (uint8_t mask = 0x80; mask != 0; mask = static_cast<uint8_t>(mask >> 1))
+        for (uint32_t i = 0; i < count; i++)
         {
-            // GRBW
-            if (mask & green)
+            if constexpr (kFamily == pixel::LedFamily::kRtzRgbw)
             {
-                BIT_SET(local_buffer[j], port_index);
+                SetLevels(port_index, first_pixel + i, kLevel(0), kLevel(1), kLevel(2), kLevel(3));
             }
             else
             {
-                BIT_CLEAR(local_buffer[j], port_index);
+                constexpr auto& kChannels = pixel::kMapChannels[kMap];
+                SetLevels(port_index, first_pixel + i, kLevel(kChannels[0]), kLevel(kChannels[1]), kLevel(kChannels[2]));
             }
 
-            if (mask & red)
-            {
-                BIT_SET(local_buffer[8 + j], port_index);
-            }
-            else
-            {
-                BIT_CLEAR(local_buffer[8 + j], port_index);
-            }
+            dmx += kSlots * 2;
+        }
+    }
+#endif
 
-            if (mask & blue)
-            {
-                BIT_SET(local_buffer[16 + j], port_index);
-            }
-            else
-            {
-                BIT_CLEAR(local_buffer[16 + j], port_index);
-            }
+    /**
+     * Copies the pixel first_pixel of a port over the next count - 1 pixels, a group
+     * is encoded once. The bytes of a port are 8 apart, so this is a strided copy.
+     */
+    template <pixel::LedFamily kFamily> void RepeatPixel(uint32_t port_index, uint32_t first_pixel, uint32_t count)
+    {
+        constexpr uint32_t kBytesPerPixel = ((kFamily == pixel::LedFamily::kRtz) || (kFamily == pixel::LedFamily::kWS2801)) ? 3 : 4;
+        constexpr uint32_t kStartFrame = ((kFamily == pixel::LedFamily::kAPA102) || (kFamily == pixel::LedFamily::kP9813)) ? 1 : 0;
 
-            if (mask & white)
-            {
-                BIT_SET(local_buffer[24 + j], port_index);
-            }
-            else
+        const auto kRepeat = [port_index, first_pixel, count](auto* buffer) {
+            auto* const source = &buffer[((kStartFrame + first_pixel) * kBytesPerPixel) * 8 + port_index];
+            auto* destination = source + (kBytesPerPixel * 8);
+
+            for (uint32_t i = 1; i < count; i++)
             {
-                BIT_CLEAR(local_buffer[24 + j], port_index);
+                for (uint32_t byte = 0; byte < kBytesPerPixel; byte++)
+                {
+                    destination[byte * 8] = source[byte * 8];
+                }
+                destination += kBytesPerPixel * 8;
             }
+        };
 
-            j++;
-        }
-
-        // Write back to m_pBuffer1
-        for (uint32_t i = 0; i < 32; i++)
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        if constexpr ((kFamily == pixel::LedFamily::kRtz) || (kFamily == pixel::LedFamily::kRtzRgbw))
         {
-            kPixelDatabuffer[kPixelIndex + i] = local_buffer[i];
+            if (is_dithering_)
+            {
+                kRepeat(level_);
+                return;
+            }
         }
+#endif
+        kRepeat(staging_);
     }
 
+    /**
+     * Copies the pixels of a port to the ports in the mask, which must have the same count and
+     * colour order. The copy has the colour matrix of the port, a mirror port has no matrix of its own.
+     * A byte is written to all 8 ports at once, the end frames are not changed.
+     */
+    void CopyPort(uint32_t port_index, uint32_t port_mask, uint32_t count);
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    /**
+     * The input has 16-bit colours, the RTZ output is then dithered. Applied with ApplyConfiguration.
+     */
+    void SetInput16Bit(bool input_16bit) { is_input_16bit_ = input_16bit; }
+#endif
+
     bool IsUpdating()
     {
         return H3SpiDmaTxIsActive(); // returns TRUE while DMA operation is active
     }
 
+    /**
+     * Does not wait: while the previous frame is sent, the update is started from Run.
+     */
     void Update();
     void Blackout();
     void FullOn();
+    void Run();
 
     uint32_t GetUserData();
 
@@ -211,65 +317,171 @@ class PixelOutputMulti final
     void SetupSPI(uint32_t speed_hz);
     bool SetupCPLD();
     void SetupBuffers();
+    void SetEndFrame(uint32_t port_index, pixel::LedType type, uint32_t count);
 
     void SetColour(uint32_t port_index, uint32_t pixel_index, uint8_t colour1, uint8_t colour2, uint8_t colour3)
     {
-        uint32_t local_buffer[24] __attribute__((aligned(32)));
-        const uint32_t kIndex = pixel_index * pixel::single::kRgb;
+        auto* const staging = &staging_[(pixel_index * 3) * 8 + port_index];
+
+        staging[0] = colour1;
+        staging[8] = colour2;
+        staging[16] = colour3;
+
+        port_mask_ |= static_cast<uint8_t>(1U << port_index);
+    }
 
-        for (uint32_t i = 0; i < 24; i++)
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    /**
+     * The level of an 8.8 DMX value, between the gamma of value and value + 1
+     */
+    uint16_t Gamma16(uint8_t value, uint8_t fraction) const
+    {
+        if ((fraction == 0) || (value == 0xFF))
         {
-            local_buffer[i] = kPixelDatabuffer[kIndex + i];
+            return gamma16_[value];
         }
 
-        uint32_t j = 0;
+        const auto kLow = static_cast<uint32_t>(gamma16_[value]);
+        return static_cast<uint16_t>(kLow + (((gamma16_[value + 1] - kLow) * fraction) >> 8));
+    }
 
-        for (uint8_t mask = 0x80; mask != 0; mask = static_cast<uint8_t>(mask >> 1))
+    /**
+     * Without dithering the level is rounded to a code in staging_
+     */
+    void SetLevels(uint32_t port_index, uint32_t pixel_index, uint16_t level1, uint16_t level2, uint16_t level3)
+    {
+        if (!is_dithering_)
         {
-            if (mask & colour1)
-            {
-                BIT_SET(local_buffer[j], port_index);
-            }
-            else
-            {
-                BIT_CLEAR(local_buffer[j], port_index);
-            }
-            if (mask & colour2)
-            {
-                BIT_SET(local_buffer[8 + j], port_index);
-            }
-            else
-            {
-                BIT_CLEAR(local_buffer[8 + j], port_index);
-            }
-            if (mask & colour3)
+            SetColour(port_index, pixel_index, pixel::ColourMatrix::Code(level1), pixel::ColourMatrix::Code(level2), pixel::ColourMatrix::Code(level3));
+            return;
+        }
+
+        auto* const level = &level_[(pixel_index * 3) * 8 + port_index];
+
+        level[0] = level1;
+        level[8] = level2;
+        level[16] = level3;
+
+        port_mask_ |= static_cast<uint8_t>(1U << port_index);
+    }
+
+    void SetLevels(uint32_t port_index, uint32_t pixel_index, uint16_t red, uint16_t green, uint16_t blue, uint16_t white)
+    {
+        if (!is_dithering_)
+        {
+            SetPixel4Bytes(port_index, pixel_index, pixel::ColourMatrix::Code(red), pixel::ColourMatrix::Code(green), pixel::ColourMatrix::Code(blue), pixel::ColourMatrix::Code(white));
+            return;
+        }
+
+        auto* const level = &level_[(pixel_index * 4) * 8 + port_index];
+
+        // GRBW, as SetPixel4Bytes
+        level[0] = green;
+        level[8] = red;
+        level[16] = blue;
+        level[24] = white;
+
+        port_mask_ |= static_cast<uint8_t>(1U << port_index);
+    }
+#endif
+
+    /**
+     * As SetPixels, the colours go through the colour matrix of the port, which includes the gamma
+     */
+    template <pixel::LedFamily kFamily, uint32_t kMap> void SetPixelsMatrix(uint32_t port_index, uint32_t first_pixel, const uint8_t* dmx, uint32_t count)
+    {
+        const auto& matrix = *matrix_[port_index];
+        [[maybe_unused]] const auto kGlobalBrightness = PixelConfiguration::Get().GetGlobalBrightness();
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const uint16_t kLevel[3] = {matrix.Level<0>(dmx[0], dmx[1], dmx[2]), matrix.Level<1>(dmx[0], dmx[1], dmx[2]), matrix.Level<2>(dmx[0], dmx[1], dmx[2])};
+
+            if constexpr (kFamily == pixel::LedFamily::kRtzRgbw)
             {
-                BIT_SET(local_buffer[16 + j], port_index);
+                const auto kWhite = matrix.LevelWhite(dmx[0], dmx[1], dmx[2], gamma16_[dmx[3]]);
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+                SetLevels(port_index, first_pixel + i, kLevel[0], kLevel[1], kLevel[2], kWhite);
+#else
+                SetPixel4Bytes(port_index, first_pixel + i, pixel::ColourMatrix::Code(kLevel[0]), pixel::ColourMatrix::Code(kLevel[1]), pixel::ColourMatrix::Code(kLevel[2]), pixel::ColourMatrix::Code(kWhite));
+#endif
+                dmx += 4;
             }
             else
             {
-                BIT_CLEAR(local_buffer[16 + j], port_index);
+                constexpr auto& kChannels = pixel::kMapChannels[kMap];
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+                if constexpr (kFamily == pixel::LedFamily::kRtz)
+                {
+                    SetLevels(port_index, first_pixel + i, kLevel[kChannels[0]], kLevel[kChannels[1]], kLevel[kChannels[2]]);
+                    dmx += 3;
+                    continue;
+                }
+#endif
+                const auto kColour1 = pixel::ColourMatrix::Code(kLevel[kChannels[0]]);
+                const auto kColour2 = pixel::ColourMatrix::Code(kLevel[kChannels[1]]);
+                const auto kColour3 = pixel::ColourMatrix::Code(kLevel[kChannels[2]]);
+
+                if constexpr ((kFamily == pixel::LedFamily::kRtz) || (kFamily == pixel::LedFamily::kWS2801))
+                {
+                    SetColour(port_index, first_pixel + i, kColour1, kColour2, kColour3);
+                }
+                else if constexpr (kFamily == pixel::LedFamily::kAPA102)
+                {
+                    SetPixel4Bytes(port_index, 1 + first_pixel + i, kGlobalBrightness, kColour3, kColour2, kColour1);
+                }
+                else
+                {
+                    static_assert(kFamily == pixel::LedFamily::kP9813);
+                    const auto kFlag = static_cast<uint8_t>(0xC0 | ((~kColour3 & 0xC0) >> 2) | ((~kColour2 & 0xC0) >> 4) | ((~kColour1 & 0xC0) >> 6));
+                    SetPixel4Bytes(port_index, 1 + first_pixel + i, kFlag, kColour3, kColour2, kColour1);
+                }
+
+                dmx += 3;
             }
-
-            j++;
-        }
-
-        // Write back to m_pBuffer1
-        for (uint32_t i = 0; i < 24; i++)
-        {
-            kPixelDatabuffer[kIndex + i] = local_buffer[i];
         }
     }
 
+    void SetupMatrices();
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    void SetupDithering();
+#endif
+    void Transpose();
+
    private:
     uint32_t buffer_size_{0};
 
     uint8_t* const kPixelDatabuffer{reinterpret_cast<uint8_t*>(H3_SRAM_A1_BASE + 512)};
+
+    /**
+     * The colour bytes, for each byte of a pixel the 8 ports. Update transposes
+     * them into the bit-planes of kPixelDatabuffer, 8 bytes at a time.
+     * The maximum is APA102: a start frame, 4 bytes per pixel and an end frame.
+     */
+    static constexpr uint32_t kMaxBytesPerPort = (pixel::max::ledcount::kRgb * 4) + 8;
+    uint8_t staging_[kMaxBytesPerPort * 8] __attribute__((aligned(8)));
+    uint8_t port_mask_{0};
+    uint8_t mirror_mask_[8]{}; ///< For each source port, the ports that mirror it
+    uint8_t matrix_mask_{0};   ///< The ports with a colour matrix
+    pixel::ColourMatrix* matrix_[8]{}; ///< The tables are 12 KiB, allocated for a port with a matrix
+    uint16_t gamma16_[256]; ///< The 16-bit level of a DMX value
     uint8_t* dma_buffer_{nullptr};
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    /**
+     * RTZ: the 16-bit level of each byte in staging_, Update dithers them into staging_.
+     * Only used when the levels can have a fraction, see SetupDithering.
+     */
+    uint16_t level_[kMaxBytesPerPort * 8];
+    uint8_t error_[kMaxBytesPerPort * 8];
+    bool is_input_16bit_{false};
+    bool is_dithering_{false};
+    bool has_fraction_{false};
+#endif
 
     JamSTAPLDisplay* jamstapl_display_{nullptr};
 
     bool has_cpld_{false};
+    bool is_update_pending_{false};
 
     static inline PixelOutputMulti* s_this;
 };
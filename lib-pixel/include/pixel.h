@@ -30,6 +30,7 @@
 #pragma GCC optimize("no-tree-loop-distribute-patterns")
 
 #include <cstdint>
+#include <cstring>
 #include <cassert>
 
 #if defined(PIXELPATTERNS_MULTI)
@@ -41,11 +42,11 @@
 #include "pixelconfiguration.h"
 
 namespace pixel {
-inline uint32_t GetColour(uint8_t red, uint8_t green, uint8_t blue) {
+inline constexpr uint32_t GetColour(uint8_t red, uint8_t green, uint8_t blue) {
     return static_cast<uint32_t>(red << 16) | static_cast<uint32_t>(green << 8) | blue;
 }
 
-inline uint32_t GetColour(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
+inline constexpr uint32_t GetColour(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
     return static_cast<uint32_t>(white << 24) | static_cast<uint32_t>(red << 16) | static_cast<uint32_t>(green << 8) | blue;
 }
 
@@ -112,14 +113,48 @@ inline void SetPixelColour([[maybe_unused]] uint32_t port_index, uint32_t pixel_
 #endif // PIXELPATTERNS_MULTI
 }
 
+inline uint32_t GetCount([[maybe_unused]] uint32_t port_index) {
+#if defined(PIXELPATTERNS_MULTI)
+    return PixelConfiguration::Get().GetPortCount(port_index);
+#else
+    return PixelConfiguration::Get().GetCount();
+#endif
+}
+
+/**
+ * The ports give the same output for the same pixels: the count, the colour order and the colour matrix.
+ */
+inline bool IsSamePort([[maybe_unused]] uint32_t port_index, [[maybe_unused]] uint32_t other_port_index) {
+#if defined(PIXELPATTERNS_MULTI)
+    const auto& pixel_configuration = PixelConfiguration::Get();
+
+    return (pixel_configuration.GetPortCount(port_index) == pixel_configuration.GetPortCount(other_port_index)) &&
+           (pixel_configuration.GetPortMap(port_index) == pixel_configuration.GetPortMap(other_port_index)) &&
+           (memcmp(pixel_configuration.GetPortMatrix(port_index), pixel_configuration.GetPortMatrix(other_port_index), pixel::ColourMatrix::kCoefficients) == 0);
+#else
+    return true;
+#endif
+}
+
 inline void SetPixelColour(uint32_t port_index, uint32_t colour) {
-    const auto kCount = PixelConfiguration::Get().GetCount();
+    const auto kCount = GetCount(port_index);
 
     for (uint32_t i = 0; i < kCount; i++) {
         SetPixelColour(port_index, i, colour);
     }
 }
 
+/**
+ * Copies the pixels of a port to the ports in the mask, see IsSamePort.
+ */
+inline void CopyPort([[maybe_unused]] uint32_t port_index, [[maybe_unused]] uint32_t port_mask) {
+#if defined(PIXELPATTERNS_MULTI)
+    auto* output_type = PixelOutputType::Get();
+    assert(output_type != nullptr);
+    output_type->CopyPort(port_index, port_mask, GetCount(port_index));
+#endif
+}
+
 inline bool IsUpdating() {
     auto* output_type = PixelOutputType::Get();
     assert(output_type != nullptr);
@@ -0,0 +1,102 @@
+/**
+ * @file pixelcolourmatrix.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#ifndef PIXELCOLOURMATRIX_H_
+#define PIXELCOLOURMATRIX_H_
+
+#include <cstdint>
+#include <algorithm>
+
+namespace pixel {
+/**
+ * A colour matrix for white balance, colour correction and RGB to RGBW.
+ * The rows are the outputs R, G, B and W, the columns the inputs R, G and B,
+ * the coefficients are in percent. The matrix works on the light, after the
+ * gamma, so the gamma and a coefficient are compiled into one table:
+ * an output is the sum of 3 table lookups.
+ */
+class ColourMatrix {
+   public:
+    static constexpr uint32_t kRows = 4;
+    static constexpr uint32_t kColumns = 3;
+    static constexpr uint32_t kCoefficients = kRows * kColumns;
+    static constexpr int32_t kOne = 100;
+
+    /**
+     * @param coefficients Row-major, kCoefficients values
+     * @param gamma The 16-bit level of each DMX value
+     */
+    void Setup(const int8_t* coefficients, const uint16_t* gamma) {
+        for (uint32_t row = 0; row < kRows; row++) {
+            for (uint32_t column = 0; column < kColumns; column++) {
+                const auto kCoefficient = static_cast<int32_t>(coefficients[row * kColumns + column]);
+
+                for (uint32_t value = 0; value < 256; value++) {
+                    table_[row][column][value] = (kCoefficient * static_cast<int32_t>(gamma[value])) / kOne;
+                }
+            }
+        }
+    }
+
+    /**
+     * @return The 16-bit level of the output kRow
+     */
+    template <uint32_t kRow> uint16_t Level(uint8_t red, uint8_t green, uint8_t blue) const {
+        static_assert(kRow < kRows);
+        const auto kSum = table_[kRow][0][red] + table_[kRow][1][green] + table_[kRow][2][blue];
+        return static_cast<uint16_t>(std::clamp(kSum, 0, 0xFFFF));
+    }
+
+    /**
+     * RGBW: the white of the DMX is added to the white from the colours
+     */
+    uint16_t LevelWhite(uint8_t red, uint8_t green, uint8_t blue, uint16_t white) const {
+        const auto kSum = table_[3][0][red] + table_[3][1][green] + table_[3][2][blue] + static_cast<int32_t>(white);
+        return static_cast<uint16_t>(std::clamp(kSum, 0, 0xFFFF));
+    }
+
+    /**
+     * The 8-bit code of a level, 0xFFFF is 0xFF
+     */
+    static constexpr uint8_t Code(uint16_t level) { return static_cast<uint8_t>((static_cast<uint32_t>(level) - (level >> 8) + 0x80) >> 8); }
+
+    /**
+     * All zero is no matrix, as is all 0xFF: the erased store of a firmware without the matrix
+     */
+    static bool IsSet(const int8_t* coefficients) {
+        return std::any_of(coefficients, coefficients + kCoefficients, [](int8_t coefficient) { return coefficient != 0; }) &&
+               std::any_of(coefficients, coefficients + kCoefficients, [](int8_t coefficient) { return coefficient != -1; });
+    }
+
+   private:
+    int32_t table_[kRows][kColumns][256];
+};
+
+static_assert(ColourMatrix::Code(0) == 0);
+static_assert(ColourMatrix::Code(0xFFFF) == 0xFF);
+static_assert(ColourMatrix::Code(0x8080) == 0x80);
+} // namespace pixel
+
+#endif // PIXELCOLOURMATRIX_H_
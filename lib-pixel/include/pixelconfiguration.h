@@ -28,10 +28,15 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <algorithm>
 #include <utility>
 #include <cassert>
 
 #include "pixeltype.h"
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+#include "pixelcolourmatrix.h"
+#endif
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
 #include "gamma/gamma_tables.h"
 #endif
@@ -39,12 +44,30 @@
 
 class PixelConfiguration {
    public:
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+#if defined(CONFIG_DMXNODE_PIXEL_MAX_PORTS)
+    static constexpr uint32_t kMaxPorts = CONFIG_DMXNODE_PIXEL_MAX_PORTS;
+#else
+    static constexpr uint32_t kMaxPorts = 8;
+#endif
+#endif
+
     PixelConfiguration() {
         DEBUG_ENTRY();
 
         assert(s_this == nullptr);
         s_this = this;
 
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+        for (auto& type : port_type_) {
+            type = pixel::LedType::kUndefined;
+        }
+
+        for (auto& mirror : port_mirror_) {
+            mirror = kMaxPorts;
+        }
+#endif
+
         DEBUG_EXIT();
     }
 
@@ -102,6 +125,103 @@ class PixelConfiguration {
 
     uint32_t GetRefreshRate() const { return refresh_rate_; }
 
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    /**
+     * A port can have less pixels than the count, 0 is the count.
+     */
+    void SetPortCount(uint32_t port_index, uint32_t count) {
+        assert(port_index < kMaxPorts);
+        port_count_[port_index] = static_cast<uint16_t>(std::min(count, pixel::max::ledcount::kRgb));
+        refresh_needed_ = true;
+    }
+
+    /**
+     * The type of a port must be of the same family as the type, otherwise the type is used.
+     * The RTZ timing is shared by all ports. A port with another type has the map of its type.
+     */
+    void SetPortType(uint32_t port_index, pixel::LedType type) {
+        assert(port_index < kMaxPorts);
+        port_type_[port_index] = (type < pixel::LedType::kUndefined) ? type : pixel::LedType::kUndefined;
+        refresh_needed_ = true;
+    }
+
+    /**
+     * Only the active ports are sent, the longest of them gives the length of the output
+     */
+    void SetActivePorts(uint32_t active_ports) {
+        active_ports = std::clamp(active_ports, 1U, kMaxPorts);
+
+        if (active_ports_ != active_ports) {
+            active_ports_ = active_ports;
+            refresh_needed_ = true;
+        }
+    }
+
+    /**
+     * A mirror port shows the pixels of the source port, which are copied in the
+     * output instead of converted again. The source must be an active port that
+     * is not a mirror itself. A source of kMaxPorts or more is no mirror.
+     */
+    void SetPortMirror(uint32_t port_index, uint32_t source_index) {
+        assert(port_index < kMaxPorts);
+        port_mirror_[port_index] = static_cast<uint8_t>(std::min(source_index, kMaxPorts));
+        refresh_needed_ = true;
+    }
+
+    /**
+     * The colour matrix of a port, see ColourMatrix. No matrix is kept as all zero.
+     * It is compiled by the output in ApplyConfiguration.
+     */
+    void SetPortMatrix(uint32_t port_index, const int8_t* coefficients) {
+        assert(port_index < kMaxPorts);
+        if (pixel::ColourMatrix::IsSet(coefficients)) {
+            memcpy(port_matrix_[port_index], coefficients, pixel::ColourMatrix::kCoefficients);
+        } else {
+            memset(port_matrix_[port_index], 0, pixel::ColourMatrix::kCoefficients);
+        }
+    }
+
+    const int8_t* GetPortMatrix(uint32_t port_index) const {
+        assert(port_index < kMaxPorts);
+        return port_matrix_[port_index];
+    }
+
+    bool HasPortMatrix(uint32_t port_index) const {
+        assert(port_index < kMaxPorts);
+        return pixel::ColourMatrix::IsSet(port_matrix_[port_index]);
+    }
+
+    bool IsPortMirror(uint32_t port_index) const {
+        assert(port_index < kMaxPorts);
+        return port_[port_index].is_mirror;
+    }
+
+    /**
+     * @return The ports that mirror the port
+     */
+    uint32_t GetPortMirrorMask(uint32_t port_index) const {
+        assert(port_index < kMaxPorts);
+        return port_[port_index].mirror_mask;
+    }
+
+    uint32_t GetPortCount(uint32_t port_index) const {
+        assert(port_index < kMaxPorts);
+        return port_[port_index].count;
+    }
+
+    pixel::LedType GetPortType(uint32_t port_index) const {
+        assert(port_index < kMaxPorts);
+        return port_[port_index].type;
+    }
+
+    pixel::LedMap GetPortMap(uint32_t port_index) const {
+        assert(port_index < kMaxPorts);
+        return port_[port_index].map;
+    }
+
+    uint32_t GetMaxPortCount() const { return max_port_count_; }
+#endif
+
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
     void SetEnableGammaCorrection(bool do_enable) { enable_gamma_correction_ = do_enable; }
 
@@ -135,6 +255,51 @@ class PixelConfiguration {
             count_ = count_ <= pixel::max::ledcount::kRgb ? count_ : pixel::max::ledcount::kRgb;
         }
 
+        [[maybe_unused]] auto longest_count = count_;
+
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+        max_port_count_ = 0;
+
+        for (uint32_t i = 0; i < kMaxPorts; i++) {
+            auto& port = port_[i];
+            const auto kType = port_type_[i];
+
+            if ((kType == pixel::LedType::kUndefined) || (kType == type_) || (pixel::GetFamily(kType) != pixel::GetFamily(type_))) {
+                port.type = type_;
+                port.map = map_;
+            } else {
+                port.type = kType;
+                port.map = GetTypeInfo(kType).led_map;
+            }
+
+            port.count = ((port_count_[i] == 0) || (port_count_[i] > count_)) ? count_ : port_count_[i];
+            port.mirror_mask = 0;
+            port.is_mirror = false;
+
+            if (i < active_ports_) {
+                max_port_count_ = std::max(max_port_count_, port.count);
+            }
+        }
+
+        // A mirror port gets the count and the type of its source
+        for (uint32_t i = 0; i < active_ports_; i++) {
+            const auto kSource = port_mirror_[i];
+
+            if ((kSource >= active_ports_) || (kSource == i) || (port_mirror_[kSource] < kMaxPorts)) {
+                continue;
+            }
+
+            auto& port = port_[i];
+            port.count = port_[kSource].count;
+            port.type = port_[kSource].type;
+            port.map = port_[kSource].map;
+            port.is_mirror = true;
+            port_[kSource].mirror_mask |= (1U << i);
+        }
+
+        longest_count = max_port_count_;
+#endif
+
         if (is_rtz_protocol_) {
             if (low_code_ >= high_code_) {
                 low_code_ = 0;
@@ -159,7 +324,7 @@ class PixelConfiguration {
             //                  8 * 1000.000
             // led time (us) =  ------------ * 8 = 10 us
             //                   6.400.000
-            const auto kLedsTime = 10U * count_ * leds_per_pixel_;
+            const auto kLedsTime = 10U * longest_count * leds_per_pixel_;
             refresh_rate_ = 1000000U / kLedsTime;
         } else {
             if ((type_ == pixel::LedType::kAPA102) || (type_ == pixel::LedType::kSK9822)) {
@@ -176,7 +341,7 @@ class PixelConfiguration {
                 }
 
                 const auto kLedTime = (8U * 1000000U) / clock_speed_hz_;
-                const auto kLedsTime = kLedTime * count_ * leds_per_pixel_;
+                const auto kLedsTime = kLedTime * longest_count * leds_per_pixel_;
                 if (kLedsTime > 0) {
                     refresh_rate_ = 1000000U / kLedsTime;
                 } else {
@@ -211,6 +376,19 @@ class PixelConfiguration {
         puts("Pixel configuration");
         printf(" Type    : %s [%u] <%u leds/pixel>\n", pixel::GetTypeName(type_), static_cast<unsigned>(type_), static_cast<unsigned>(leds_per_pixel_));
         printf(" Count   : %u\n", static_cast<unsigned>(count_));
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+        for (uint32_t i = 0; i < active_ports_; i++) {
+            const auto& port = port_[i];
+            if (port.is_mirror) {
+                printf("  Port %c : mirror of %c\n", static_cast<char>('A' + i), static_cast<char>('A' + port_mirror_[i]));
+            } else if ((port.count != count_) || (port.type != type_)) {
+                printf("  Port %c : %u %s\n", static_cast<char>('A' + i), static_cast<unsigned>(port.count), pixel::GetTypeName(port.type));
+            }
+            if (HasPortMatrix(i)) {
+                printf("  Port %c : colour matrix\n", static_cast<char>('A' + i));
+            }
+        }
+#endif
 
         if (is_rtz_protocol_) {
             printf(" Mapping : %s [%u]\n", pixel::GetMapName(map_), static_cast<unsigned>(map_));
@@ -250,6 +428,23 @@ class PixelConfiguration {
     uint8_t global_brightness_{0xFF};
     uint32_t refresh_rate_{0};
     bool refresh_needed_{true};
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    struct Port {
+        uint32_t count{pixel::defaults::kCount};
+        pixel::LedType type{pixel::defaults::kType};
+        pixel::LedMap map{pixel::LedMap::kUndefined};
+        uint32_t mirror_mask{0}; ///< The ports that mirror this port
+        bool is_mirror{false};
+    };
+
+    Port port_[kMaxPorts];
+    uint16_t port_count_[kMaxPorts]{};
+    pixel::LedType port_type_[kMaxPorts];
+    uint8_t port_mirror_[kMaxPorts]; ///< The source port, kMaxPorts is none
+    int8_t port_matrix_[kMaxPorts][pixel::ColourMatrix::kCoefficients]{};
+    uint32_t active_ports_{kMaxPorts};
+    uint32_t max_port_count_{pixel::defaults::kCount};
+#endif
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
     uint8_t gamma_value_{0};
     bool enable_gamma_correction_{false};
@@ -0,0 +1,72 @@
+/**
+ * @file pixeldither.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELDITHER_H_
+#define PIXELDITHER_H_
+
+#include <cstdint>
+#include <cmath>
+
+namespace pixel::dither {
+inline constexpr uint32_t kLinear = 10; ///< Gamma 1.0
+
+/**
+ * The 16-bit level of a DMX value on a gamma curve, the gamma value is in 1/10.
+ */
+inline void SetupGamma(uint16_t* table, uint32_t gamma_value) {
+    const auto kGamma = static_cast<float>(gamma_value) / 10.0f;
+
+    for (uint32_t value = 0; value < 256; value++) {
+        if (gamma_value == kLinear) {
+            table[value] = static_cast<uint16_t>(value * 257U);
+        } else {
+            table[value] = static_cast<uint16_t>(lroundf(65535.0f * powf(static_cast<float>(value) / 255.0f, kGamma)));
+        }
+    }
+}
+
+/**
+ * Temporal dithering of 16-bit levels into 8-bit codes. The level is scaled to 8.8
+ * fixed point with 0xFFFF as 255.0, so v * 257 is the code v without a fraction.
+ * The fraction is kept in the error of the colour and added at the next refresh,
+ * over 256 refreshes the average of the codes is the level.
+ * @return Not 0 when a level has a fraction, the output then changes at each refresh
+ */
+inline uint32_t Encode(const uint16_t* level, uint8_t* error, uint8_t* code, uint32_t count) {
+    uint32_t fraction = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const auto kLevel = static_cast<uint32_t>(level[i]) - (level[i] >> 8); // 0..0xFF00
+        const auto kSum = kLevel + error[i];                                      // 0..0xFFFF
+
+        code[i] = static_cast<uint8_t>(kSum >> 8);
+        error[i] = static_cast<uint8_t>(kSum);
+        fraction |= kLevel;
+    }
+
+    return fraction & 0xFF;
+}
+} // namespace pixel::dither
+
+#endif // PIXELDITHER_H_
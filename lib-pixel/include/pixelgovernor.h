@@ -0,0 +1,172 @@
+/**
+ * @file pixelgovernor.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELGOVERNOR_H_
+#define PIXELGOVERNOR_H_
+
+#include <cstdint>
+#include <cassert>
+
+namespace pixel {
+/**
+ * Decides when a frame is sent to the pixels. A frame is the set of expected
+ * parts (universes); it is due when all parts are in, when a part arrives
+ * again before the frame was complete (the missing part is lost), or when the
+ * deadline after the first part has expired (the missing part is late).
+ * A due frame waits for the minimum period, the refresh rate the strip allows.
+ *
+ * All times are in microseconds, Poll must be called from the superloop.
+ */
+class Governor {
+   public:
+    static constexpr uint32_t kMaxParts = 64;
+    static constexpr uint32_t kDeadlineMillisDefault = 25; ///< 40 Hz
+
+    Governor() {
+        assert(s_this == nullptr);
+        s_this = this;
+    }
+
+    /**
+     * Clears the expected parts and the frame in progress
+     */
+    void Reset() {
+        expected_ = 0;
+        received_ = 0;
+        is_due_ = false;
+    }
+
+    void SetExpected(uint32_t part) {
+        assert(part < kMaxParts);
+        expected_ |= (static_cast<uint64_t>(1) << part);
+    }
+
+    /**
+     * @param deadline_millis 0 is the default
+     */
+    void SetDeadlineMillis(uint32_t deadline_millis) { deadline_micros_ = 1000U * ((deadline_millis == 0) ? kDeadlineMillisDefault : deadline_millis); }
+
+    uint32_t GetDeadlineMillis() const { return deadline_micros_ / 1000U; }
+
+    /**
+     * @param refresh_rate The maximum frames per second, 0 is no limit
+     */
+    void SetRefreshRate(uint32_t refresh_rate) { min_period_micros_ = (refresh_rate == 0) ? 0 : (1000000U / refresh_rate); }
+
+    /**
+     * A part has been written into the output buffer.
+     * @return true when the frame must be output now
+     */
+    bool Receive(uint32_t part, uint32_t micros) {
+        micros_ = micros;
+
+        if (part >= kMaxParts) {
+            return false;
+        }
+
+        const auto kBit = static_cast<uint64_t>(1) << part;
+
+        if ((expected_ & kBit) == 0) {
+            return false;
+        }
+
+        if ((received_ & kBit) != 0) {
+            partial_frames_++;
+            is_due_ = true;
+            received_ = 0;
+        }
+
+        if (received_ == 0) {
+            frame_micros_ = micros;
+        }
+
+        received_ |= kBit;
+
+        if (received_ == expected_) {
+            is_due_ = true;
+            received_ = 0;
+        }
+
+        return IsDue(micros);
+    }
+
+    /**
+     * Checks the deadline and the rate limit, and updates the frames per second.
+     * @return true when the frame must be output now
+     */
+    bool Poll(uint32_t micros) {
+        micros_ = micros;
+
+        if ((micros - fps_micros_) >= 1000000U) {
+            fps_micros_ = micros;
+            fps_ = frames_;
+            frames_ = 0;
+        }
+
+        if ((received_ != 0) && ((micros - frame_micros_) >= deadline_micros_)) {
+            late_frames_++;
+            is_due_ = true;
+            received_ = 0;
+        }
+
+        return IsDue(micros);
+    }
+
+    /**
+     * The due frame has been sent to the output, at the time of the last Receive or Poll
+     */
+    void Output() {
+        is_due_ = false;
+        output_micros_ = micros_;
+        frames_++;
+    }
+
+    uint32_t GetFps() const { return fps_; }
+    uint32_t GetLateFrames() const { return late_frames_; }       ///< Output at the deadline
+    uint32_t GetPartialFrames() const { return partial_frames_; } ///< Output when the next frame started
+
+    static Governor* Get() { return s_this; }
+
+   private:
+    bool IsDue(uint32_t micros) const { return is_due_ && ((micros - output_micros_) >= min_period_micros_); }
+
+    uint64_t expected_{0};
+    uint64_t received_{0};
+    uint32_t micros_{0};
+    uint32_t frame_micros_{0};
+    uint32_t output_micros_{0};
+    uint32_t deadline_micros_{1000U * kDeadlineMillisDefault};
+    uint32_t min_period_micros_{0};
+    uint32_t fps_micros_{0};
+    uint32_t frames_{0};
+    uint32_t fps_{0};
+    uint32_t late_frames_{0};
+    uint32_t partial_frames_{0};
+    bool is_due_{false};
+
+    static inline Governor* s_this;
+};
+} // namespace pixel
+
+#endif // PIXELGOVERNOR_H_
@@ -26,11 +26,15 @@
 #define PIXELOUTPUT_H_
 
 #include <cstdint>
+#include <cstring>
+#include <cassert>
 
+#include "pixeltype.h"
+#include "pixelconfiguration.h"
 #if defined(GD32)
 #include "gd32_spi.h"
-#elif defined(H3)
-#include "h3_spi.h"
+#else
+#include "pixelspidma.h"
 #endif
 
 class PixelOutput
@@ -44,20 +48,130 @@ class PixelOutput
     void SetPixel(uint32_t index, uint8_t red, uint8_t green, uint8_t blue);
     void SetPixel(uint32_t index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white);
 
+    /**
+     * The write path of a LED family, the type is not checked.
+     */
+    template <pixel::LedFamily kFamily> void SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue) {
+        const uint8_t kColours[3] = {red, green, blue};
+        SetPixels<kFamily, static_cast<uint32_t>(pixel::LedMap::kRGB)>(pixel_index, kColours, 1);
+    }
+
+    /**
+     * Writes count pixels from consecutive DMX slots, kMap gives the slots of the colours.
+     */
+    template <pixel::LedFamily kFamily, uint32_t kMap> void SetPixels(uint32_t first_pixel, const uint8_t* dmx, uint32_t count) {
+        assert(buffer_ != nullptr);
+        assert(dmx != nullptr);
+        assert((first_pixel + count) <= PixelConfiguration::Get().GetCount());
+
+        if constexpr (kFamily == pixel::LedFamily::kRtzRgbw) {
+            auto offset = first_pixel * 32U;
+
+            for (uint32_t i = 0; i < count; i++) {
+                // GRBW
+                SetColorWS28xx(offset, dmx[1]);
+                SetColorWS28xx(offset + 8, dmx[0]);
+                SetColorWS28xx(offset + 16, dmx[2]);
+                SetColorWS28xx(offset + 24, dmx[3]);
+                offset += 32;
+                dmx += 4;
+            }
+        } else if constexpr (kFamily == pixel::LedFamily::kRtz) {
+            constexpr auto& kChannels = pixel::kMapChannels[kMap];
+            auto offset = first_pixel * 24U;
+
+            for (uint32_t i = 0; i < count; i++) {
+                SetColorWS28xx(offset, dmx[kChannels[0]]);
+                SetColorWS28xx(offset + 8, dmx[kChannels[1]]);
+                SetColorWS28xx(offset + 16, dmx[kChannels[2]]);
+                offset += 24;
+                dmx += 3;
+            }
+        } else {
+            constexpr auto& kChannels = pixel::kMapChannels[kMap];
+            auto* const buffer = buffer_;
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+            const auto* const kGammaTable = PixelConfiguration::Get().GetGammaTable();
+#endif
+            [[maybe_unused]] const auto kGlobalBrightness = PixelConfiguration::Get().GetGlobalBrightness();
+
+            for (uint32_t i = 0; i < count; i++) {
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+                const auto kRed = kGammaTable[dmx[kChannels[0]]];
+                const auto kGreen = kGammaTable[dmx[kChannels[1]]];
+                const auto kBlue = kGammaTable[dmx[kChannels[2]]];
+#else
+                const auto kRed = dmx[kChannels[0]];
+                const auto kGreen = dmx[kChannels[1]];
+                const auto kBlue = dmx[kChannels[2]];
+#endif
+                if constexpr (kFamily == pixel::LedFamily::kWS2801) {
+                    const auto kOffset = (first_pixel + i) * 3U;
+                    assert(kOffset + 2U < buf_size_);
+
+                    buffer[kOffset] = kRed;
+                    buffer[kOffset + 1] = kGreen;
+                    buffer[kOffset + 2] = kBlue;
+                } else if constexpr (kFamily == pixel::LedFamily::kAPA102) {
+                    const auto kOffset = 4U + ((first_pixel + i) * 4U);
+                    assert(kOffset + 3U < buf_size_);
+
+                    buffer[kOffset] = kGlobalBrightness;
+                    buffer[kOffset + 1] = kRed;
+                    buffer[kOffset + 2] = kGreen;
+                    buffer[kOffset + 3] = kBlue;
+                } else {
+                    static_assert(kFamily == pixel::LedFamily::kP9813);
+                    const auto kOffset = 4U + ((first_pixel + i) * 4U);
+                    assert(kOffset + 3 < buf_size_);
+
+                    buffer[kOffset] = static_cast<uint8_t>(0xC0 | ((~kBlue & 0xC0) >> 2) | ((~kGreen & 0xC0) >> 4) | ((~kRed & 0xC0) >> 6));
+                    buffer[kOffset + 1] = kBlue;
+                    buffer[kOffset + 2] = kGreen;
+                    buffer[kOffset + 3] = kRed;
+                }
+
+                dmx += 3;
+            }
+        }
+    }
+
+    /**
+     * Copies the encoded pixel first_pixel over the next count - 1 pixels, a group
+     * is encoded once. The copied part doubles each step.
+     */
+    template <pixel::LedFamily kFamily> void RepeatPixel(uint32_t first_pixel, uint32_t count) {
+        assert(buffer_ != nullptr);
+        assert((first_pixel + count) <= PixelConfiguration::Get().GetCount());
+
+        constexpr uint32_t kBytesPerPixel = (kFamily == pixel::LedFamily::kRtzRgbw) ? 32 : (kFamily == pixel::LedFamily::kRtz) ? 24 : (kFamily == pixel::LedFamily::kWS2801) ? 3 : 4;
+        constexpr uint32_t kOffset = (kFamily == pixel::LedFamily::kWS2801) ? 0 : ((kFamily == pixel::LedFamily::kAPA102) || (kFamily == pixel::LedFamily::kP9813)) ? 4 : 1;
+
+        auto* const source = &buffer_[kOffset + (first_pixel * kBytesPerPixel)];
+        const auto kTotal = count * kBytesPerPixel;
+
+        for (uint32_t copied = kBytesPerPixel; copied < kTotal; copied *= 2) {
+            memcpy(&source[copied], source, (copied <= (kTotal - copied)) ? copied : (kTotal - copied));
+        }
+    }
+
     bool IsUpdating()
     {
 #if defined(GD32)
         return i2s::Gd32SpiDmaTxIsActive();
-#elif defined(H3)
-        return H3SpiDmaTxIsActive();
 #else
-        return false;
+        return pixel::spidma::TxIsActive();
 #endif
     }
 
+    /**
+     * The frame is composed in a buffer that is not transmitted. When the previous
+     * frame is still being sent, the update is started from Run.
+     */
     void Update();
     void Blackout();
     void FullOn();
+    void Run();
 
     uint32_t GetUserData()
     { // TODO(a): implement GetUserData
@@ -68,12 +182,30 @@ class PixelOutput
 
    private:
     void SetupBuffers();
-    void SetColorWS28xx(uint32_t offset, uint8_t value);
+    void SetupTable();
+
+    /**
+     * The first byte of the buffer is 0x00, the bit pattern of a colour is then at an odd offset.
+     */
+    void SetColorWS28xx(uint32_t offset, uint8_t value) {
+        assert(buffer_ != nullptr);
+        assert(offset + 8 < buf_size_);
+
+        memcpy(&buffer_[offset + 1], table_[value], 8);
+    }
 
    private:
+    enum class Pending : uint8_t { kNone, kUpdate, kBlackout };
+
     uint32_t buf_size_;
-    uint8_t* buffer_{nullptr};
+    uint8_t* buffer_{nullptr}; ///< The frame that is composed
+    uint8_t* buffers_[2]{nullptr, nullptr};
     uint8_t* blackout_buffer_{nullptr};
+    Pending pending_{Pending::kNone};
+    /**
+     * RTZ protocol: the SPI bit pattern of a colour value, gamma included.
+     */
+    uint8_t table_[256][8] __attribute__((aligned(4)));
 
     static inline PixelOutput* s_this;
 };
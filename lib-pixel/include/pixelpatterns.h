@@ -64,6 +64,39 @@ inline constexpr char kPatternName[static_cast<uint32_t>(pixelpatterns::Pattern:
 };
 
 enum class Direction { kForward, kReverse };
+
+inline constexpr uint32_t Wheel(uint8_t wheel_position) {
+    wheel_position = static_cast<uint8_t>(255U - wheel_position);
+
+    if (wheel_position < 85) {
+        return pixel::GetColour(static_cast<uint8_t>(255U - wheel_position * 3), 0, static_cast<uint8_t>(wheel_position * 3));
+    } else if (wheel_position < 170U) {
+        wheel_position = static_cast<uint8_t>(wheel_position - 85U);
+        return pixel::GetColour(0, static_cast<uint8_t>(wheel_position * 3), static_cast<uint8_t>(255U - wheel_position * 3));
+    } else {
+        wheel_position = static_cast<uint8_t>(wheel_position - 170U);
+        return pixel::GetColour(static_cast<uint8_t>(wheel_position * 3), static_cast<uint8_t>(255U - wheel_position * 3), 0);
+    }
+}
+
+/**
+ * One cycle of the rainbow, the colour of each wheel position.
+ */
+struct WheelTable {
+    uint32_t colour[256];
+};
+
+inline constexpr WheelTable MakeWheelTable() {
+    WheelTable table{};
+
+    for (uint32_t i = 0; i < 256; i++) {
+        table.colour[i] = Wheel(static_cast<uint8_t>(i));
+    }
+
+    return table;
+}
+
+inline constexpr auto kWheel = MakeWheelTable();
 } // namespace pixelpatterns
 
 class PixelPatterns {
@@ -96,6 +129,8 @@ class PixelPatterns {
         s_port_config[port_index].active_pattern = pixelpatterns::Pattern::kRainbowCycle;
         s_port_config[port_index].interval = interval;
         s_port_config[port_index].total_steps = 255;
+        s_port_config[port_index].colour1 = 0;
+        s_port_config[port_index].colour2 = 0;
         s_port_config[port_index].pixel_index = 0;
         s_port_config[port_index].direction = direction;
     }
@@ -105,7 +140,7 @@ class PixelPatterns {
 
         s_port_config[port_index].active_pattern = pixelpatterns::Pattern::kTheaterChase;
         s_port_config[port_index].interval = interval;
-        s_port_config[port_index].total_steps = PixelConfiguration::Get().GetCount();
+        s_port_config[port_index].total_steps = pixel::GetCount(port_index);
         s_port_config[port_index].colour1 = colour1;
         s_port_config[port_index].colour2 = colour2;
         s_port_config[port_index].pixel_index = 0;
@@ -117,8 +152,9 @@ class PixelPatterns {
 
         s_port_config[port_index].active_pattern = pixelpatterns::Pattern::kColorWipe;
         s_port_config[port_index].interval = interval;
-        s_port_config[port_index].total_steps = PixelConfiguration::Get().GetCount();
+        s_port_config[port_index].total_steps = pixel::GetCount(port_index);
         s_port_config[port_index].colour1 = colour;
+        s_port_config[port_index].colour2 = 0;
         s_port_config[port_index].pixel_index = 0;
         s_port_config[port_index].direction = direction;
     }
@@ -146,48 +182,99 @@ class PixelPatterns {
         DEBUG_EXIT();
     }
 
+    /**
+     * The ports that show the same frame are rendered once, the others are copies.
+     */
     void Run() {
         if (pixel::IsUpdating()) {
             return;
         }
 
-        auto is_updated = false;
         const auto kMillis = timing::Millis();
+        uint32_t due_mask = 0;
 
         for (uint32_t i = 0; i < s_active_ports; i++) {
-            is_updated |= PortUpdate(i, kMillis);
+            auto& config = s_port_config[i];
+
+            if ((config.active_pattern == pixelpatterns::Pattern::kNone) || ((kMillis - config.last_update) < config.interval)) {
+                continue;
+            }
+
+            config.last_update = kMillis;
+            due_mask |= (1U << i);
+        }
+
+        if (due_mask == 0) {
+            return;
         }
 
-        if (is_updated) {
-            pixel::Update();
+        while (due_mask != 0) {
+            const auto kPortIndex = static_cast<uint32_t>(__builtin_ctz(due_mask));
+            due_mask &= (due_mask - 1);
+
+            uint32_t copy_mask = 0;
+
+            // A colour wipe sets a single pixel, which is less than a copy
+            if (s_port_config[kPortIndex].active_pattern != pixelpatterns::Pattern::kColorWipe) {
+                for (auto mask = due_mask; mask != 0; mask &= (mask - 1)) {
+                    const auto kOther = static_cast<uint32_t>(__builtin_ctz(mask));
+
+                    if (IsSameFrame(kPortIndex, kOther)) {
+                        copy_mask |= (1U << kOther);
+                    }
+                }
+            }
+
+            due_mask &= ~copy_mask;
+
+            PortUpdate(kPortIndex);
+
+            if (copy_mask != 0) {
+                pixel::CopyPort(kPortIndex, copy_mask);
+            }
+
+            Increment(kPortIndex);
+
+            for (; copy_mask != 0; copy_mask &= (copy_mask - 1)) {
+                Increment(static_cast<uint32_t>(__builtin_ctz(copy_mask)));
+            }
         }
+
+        pixel::Update();
     }
 
    private:
     void RainbowCycleUpdate(uint32_t port_index) {
         const auto kIndex = s_port_config[port_index].pixel_index;
+        const auto kCount = pixel::GetCount(port_index);
 
-        for (uint32_t i = 0; i < PixelConfiguration::Get().GetCount(); i++) {
-            pixel::SetPixelColour(port_index, i, Wheel(((i * 256U / PixelConfiguration::Get().GetCount()) + kIndex) & 0xFF));
+        if (kCount == 0) {
+            return;
         }
 
-        Increment(port_index);
+        // The wheel position of pixel i is i * 256 / count, stepped in 16.16 fixed point
+        const auto kStep = (256U << 16) / kCount;
+        uint32_t position = 0;
+
+        for (uint32_t i = 0; i < kCount; i++) {
+            pixel::SetPixelColour(port_index, i, pixelpatterns::kWheel.colour[((position >> 16) + kIndex) & 0xFF]);
+            position += kStep;
+        }
     }
 
     void TheaterChaseUpdate(uint32_t port_index) {
         const auto kColour1 = s_port_config[port_index].colour1;
         const auto kColour2 = s_port_config[port_index].colour2;
-        const auto kPixelIndex = s_port_config[port_index].pixel_index;
+        const auto kCount = pixel::GetCount(port_index);
+        auto phase = s_port_config[port_index].pixel_index % 3;
 
-        for (uint32_t i = 0; i < PixelConfiguration::Get().GetCount(); i++) {
-            if ((i + kPixelIndex) % 3 == 0) {
-                pixel::SetPixelColour(port_index, i, kColour1);
-            } else {
-                pixel::SetPixelColour(port_index, i, kColour2);
+        for (uint32_t i = 0; i < kCount; i++) {
+            pixel::SetPixelColour(port_index, i, (phase == 0) ? kColour1 : kColour2);
+
+            if (++phase == 3) {
+                phase = 0;
             }
         }
-
-        Increment(port_index);
     }
 
     void ColourWipeUpdate(uint32_t port_index) {
@@ -195,7 +282,6 @@ class PixelPatterns {
         const auto kIndex = s_port_config[port_index].pixel_index;
 
         pixel::SetPixelColour(port_index, kIndex, kColour1);
-        Increment(port_index);
     }
 
     void FadeUpdate(uint32_t port_index) {
@@ -215,17 +301,9 @@ class PixelPatterns {
         const auto kBlue = kInterp(kColor1.Blue(), kColor2.Blue());
 
         pixel::SetPixelColour(port_index, pixel::GetColour(kRed, kGreen, kBlue));
-
-        Increment(port_index);
     }
 
-    bool PortUpdate(uint32_t port_index, uint32_t millis) {
-        if ((millis - s_port_config[port_index].last_update) < s_port_config[port_index].interval) {
-            return false;
-        }
-
-        s_port_config[port_index].last_update = millis;
-
+    void PortUpdate(uint32_t port_index) {
         switch (s_port_config[port_index].active_pattern) {
             case pixelpatterns::Pattern::kRainbowCycle:
                 RainbowCycleUpdate(port_index);
@@ -240,25 +318,17 @@ class PixelPatterns {
                 FadeUpdate(port_index);
                 break;
             default:
-                return false;
                 break;
         }
-
-        return true;
     }
 
-    uint32_t Wheel(uint8_t wheel_position) {
-        wheel_position = static_cast<uint8_t>(255U - wheel_position);
+    bool IsSameFrame(uint32_t port_index, uint32_t other_port_index) const {
+        const auto& config = s_port_config[port_index];
+        const auto& other = s_port_config[other_port_index];
 
-        if (wheel_position < 85) {
-            return pixel::GetColour(static_cast<uint8_t>(255U - wheel_position * 3), 0, static_cast<uint8_t>(wheel_position * 3));
-        } else if (wheel_position < 170U) {
-            wheel_position = static_cast<uint8_t>(wheel_position - 85U);
-            return pixel::GetColour(0, static_cast<uint8_t>(wheel_position * 3), static_cast<uint8_t>(255U - wheel_position * 3));
-        } else {
-            wheel_position = static_cast<uint8_t>(wheel_position - 170U);
-            return pixel::GetColour(static_cast<uint8_t>(wheel_position * 3), static_cast<uint8_t>(255U - wheel_position * 3), 0);
-        }
+        return (config.active_pattern == other.active_pattern) && (config.pixel_index == other.pixel_index) && (config.total_steps == other.total_steps) &&
+               (config.colour1 == other.colour1) && (config.colour2 == other.colour2) && (config.direction == other.direction) &&
+               pixel::IsSamePort(port_index, other_port_index);
     }
 
     void Increment(uint32_t port_index) {
@@ -0,0 +1,99 @@
+/**
+ * @file pixelspidma.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELSPIDMA_H_
+#define PIXELSPIDMA_H_
+
+#include <cstdint>
+
+#if defined(H3)
+#include "h3_spi.h"
+#else
+#include <thread>
+
+#include "spi.h"
+#endif
+
+/**
+ * The SPI TX DMA that sends the frames of PixelOutput. The encoder is shared,
+ * only these calls differ per platform. On Linux the DMA is the output thread of lib-linux.
+ */
+namespace pixel::spidma {
+#if defined(H3)
+inline void Begin() {
+    H3SpiBegin();
+}
+
+inline void SetSpeedHz(uint32_t speed_hz) {
+    H3SpiSetSpeedHz(speed_hz);
+}
+
+inline uint8_t* TxPrepare(uint32_t* size) {
+    return const_cast<uint8_t*>(H3SpiDmaTxPrepare(size));
+}
+
+inline void TxStart(const uint8_t* buffer, uint32_t length) {
+    H3SpiDmaTxStart(buffer, length);
+}
+
+inline bool TxIsActive() {
+    return H3SpiDmaTxIsActive();
+}
+
+inline void TxWait() {
+    do {
+        asm volatile("isb" ::: "memory");
+    } while (H3SpiDmaTxIsActive());
+}
+#else
+inline void Begin() {
+    spi::Begin();
+    spi::SetDataMode(spi::kMode0);
+}
+
+inline void SetSpeedHz(uint32_t speed_hz) {
+    spi::SetSpeedHz(speed_hz);
+}
+
+inline uint8_t* TxPrepare(uint32_t* size) {
+    return const_cast<uint8_t*>(spi::DmaTxPrepare(size));
+}
+
+inline void TxStart(const uint8_t* buffer, uint32_t length) {
+    spi::DmaTxStart(buffer, length);
+}
+
+inline bool TxIsActive() {
+    return spi::DmaTxIsActive();
+}
+
+inline void TxWait() {
+    while (spi::DmaTxIsActive()) {
+        std::this_thread::yield();
+    }
+}
+#endif
+} // namespace pixel::spidma
+
+#endif // PIXELSPIDMA_H_
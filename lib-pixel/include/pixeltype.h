@@ -105,8 +105,8 @@ struct TypeInfo {
     [[nodiscard]] constexpr bool IsSpi() const { return protocol_type == ProtocolType::kSpi; }
 };
 
-static_assert(sizeof(TypeInfo) == 20, "TypeInfo must remain compact");
-static_assert(alignof(TypeInfo) == 4, "Unexpected TypeInfo alignment");
+static_assert(sizeof(TypeInfo) == ((sizeof(const char*) == 4) ? 20 : 24), "TypeInfo must remain compact");
+static_assert(alignof(TypeInfo) == alignof(const char*), "Unexpected TypeInfo alignment");
 
 constexpr TypeInfo MakeSpiTypeInfo(const char* name, LedCount led_count, uint32_t default_hz, uint32_t max_hz) {
     return TypeInfo{.name = name, .default_hz = default_hz, .max_hz = max_hz, .protocol_type = ProtocolType::kSpi, .led_count = led_count, .low_code = kNoCode, .high_code = kNoCode, .led_map = LedMap::kRGB};
@@ -172,6 +172,47 @@ constexpr const TypeInfo& GetTypeInfo(LedType type) {
     return kTypeInfo[static_cast<uint32_t>(type)];
 }
 
+/**
+ * The LED types that share a write path
+ */
+enum class LedFamily : uint8_t {
+    kRtz,     ///< 3 colours
+    kRtzRgbw, ///< 4 colours
+    kWS2801,  //
+    kAPA102,  ///< APA102, SK9822
+    kP9813    //
+};
+
+constexpr LedFamily GetFamily(LedType type) {
+    switch (type) {
+        case LedType::kWS2801:
+            return LedFamily::kWS2801;
+        case LedType::kAPA102:
+        case LedType::kSK9822:
+            return LedFamily::kAPA102;
+        case LedType::kP9813:
+            return LedFamily::kP9813;
+        case LedType::kSK6812W:
+            return LedFamily::kRtzRgbw;
+        default:
+            break;
+    }
+
+    return LedFamily::kRtz;
+}
+
+/**
+ * The DMX channels of the 3 colours in output order, indexed with LedMap
+ */
+inline constexpr uint8_t kMapChannels[static_cast<uint32_t>(LedMap::kRGBW)][3] = {
+    {0, 1, 2}, // RGB
+    {0, 2, 1}, // RBG
+    {1, 0, 2}, // GRB
+    {2, 0, 1}, // GBR
+    {1, 2, 0}, // BRG
+    {2, 1, 0}  // BGR
+};
+
 inline void GetTxH(LedType type, uint8_t& low_code, uint8_t& high_code) {
     const auto& info = GetTypeInfo(type);
 
@@ -34,6 +34,7 @@
 #include <cstdint>
 #include <cstring>
 #include <cstdio>
+#include <algorithm>
 #include <cassert>
 
 #include "pixeloutputmulti.h"
@@ -63,13 +64,96 @@ inline uint8_t PixelOutputMulti::ReverseBits(uint8_t bits) {
     return static_cast<uint8_t>((output >> 24));
 }
 
+/**
+ * An 8x8 bit-matrix transpose, Hacker's Delight 7-3, for each byte of a pixel:
+ * the colour bytes of the 8 ports in, the 8 bit-planes out.
+ * Bit n of bit-plane j is bit (7 - j) of the byte of port n.
+ */
+void PixelOutputMulti::Transpose() {
+    const auto* __restrict__ staging = reinterpret_cast<const uint32_t*>(staging_);
+    auto* __restrict__ planes = reinterpret_cast<uint32_t*>(kPixelDatabuffer);
+    const auto kBytes = buffer_size_ / 8;
+
+    kPixelDatabuffer[buffer_size_ - 1] = 0;
+
+    if ((port_mask_ & 0xF0) == 0) {
+        // Ports 4-7 are not used, their half of the matrix is 0
+        for (uint32_t i = 0; i < kBytes; i++) {
+            auto y = staging[0];
+            uint32_t t;
+
+            t = (y ^ (y >> 7)) & 0x00AA00AA;
+            y = y ^ t ^ (t << 7);
+            t = (y ^ (y >> 14)) & 0x0000CCCC;
+            y = y ^ t ^ (t << 14);
+
+            planes[0] = __builtin_bswap32((y >> 4) & 0x0F0F0F0F);
+            planes[1] = __builtin_bswap32(y & 0x0F0F0F0F);
+
+            staging += 2;
+            planes += 2;
+        }
+
+        return;
+    }
+
+    for (uint32_t i = 0; i < kBytes; i++) {
+        auto x = staging[1]; // Ports 7..4
+        auto y = staging[0]; // Ports 3..0
+        uint32_t t;
+
+        t = (x ^ (x >> 7)) & 0x00AA00AA;
+        x = x ^ t ^ (t << 7);
+        t = (y ^ (y >> 7)) & 0x00AA00AA;
+        y = y ^ t ^ (t << 7);
+
+        t = (x ^ (x >> 14)) & 0x0000CCCC;
+        x = x ^ t ^ (t << 14);
+        t = (y ^ (y >> 14)) & 0x0000CCCC;
+        y = y ^ t ^ (t << 14);
+
+        t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+        y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+
+        planes[0] = __builtin_bswap32(t);
+        planes[1] = __builtin_bswap32(y);
+
+        staging += 2;
+        planes += 2;
+    }
+}
+
+/**
+ * The frame is composed in staging_, the DMA buffer is only written when the
+ * previous frame is sent. Otherwise the update is started from Run.
+ */
 void PixelOutputMulti::Update() {
-    do { // https://github.com/vanvught/rpidmx512/issues/281
-        __ISB();
-    } while (H3SpiDmaTxIsActive());
+    __ISB(); // https://github.com/vanvught/rpidmx512/issues/281
+
+    if (H3SpiDmaTxIsActive()) {
+        is_update_pending_ = true;
+        return;
+    }
+
+    is_update_pending_ = false;
 
     logic_analyzer::Ch2Set();
 
+    // The mirror ports are not converted, they get a copy of their source
+    for (uint32_t port_index = 0; port_index < 8; port_index++) {
+        if (mirror_mask_[port_index] != 0) {
+            CopyPort(port_index, mirror_mask_[port_index], PixelConfiguration::Get().GetPortCount(port_index));
+        }
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    if (is_dithering_) {
+        has_fraction_ = pixel::dither::Encode(level_, error_, staging_, buffer_size_ & ~7U) != 0;
+    }
+#endif
+
+    Transpose();
+
     dma::memcpy32(dma_buffer_, kPixelDatabuffer, buffer_size_);
 
     while (dma::memcpy32_is_active());
@@ -81,43 +165,83 @@ void PixelOutputMulti::Update() {
     sv_nUpdates = sv_nUpdates + 1;
 }
 
+void PixelOutputMulti::CopyPort(uint32_t port_index, uint32_t port_mask, uint32_t count) {
+    assert(port_index < 8);
+    assert(port_mask < 0x100);
+    assert((port_mask & (1U << port_index)) == 0);
+#ifndef NDEBUG
+    for (auto mask_ports = port_mask; mask_ports != 0; mask_ports &= (mask_ports - 1)) {
+        const auto kOther = static_cast<uint32_t>(__builtin_ctz(mask_ports));
+        assert(PixelConfiguration::Get().GetPortCount(kOther) == count);
+        assert(PixelConfiguration::Get().GetPortMap(kOther) == PixelConfiguration::Get().GetPortMap(port_index));
+    }
+#endif
+
+    const auto kType = PixelConfiguration::Get().GetType();
+    const auto kBytes = ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) ? ((1U + count) * 4U) : (count * PixelConfiguration::Get().GetLedsPerPixel());
+
+    // The byte lanes of the ports in the mask, a row of staging_ is 2 words
+    uint32_t mask[2] = {0, 0};
+
+    for (uint32_t i = 0; i < 8; i++) {
+        if ((port_mask & (1U << i)) != 0) {
+            mask[i / 4] |= (0xFFU << ((i & 3) * 8));
+        }
+    }
+
+    auto* row = reinterpret_cast<uint32_t*>(staging_);
+
+    for (uint32_t i = 0; i < kBytes; i++) {
+        const auto kValue = 0x01010101U * staging_[i * 8 + port_index];
+
+        row[0] = (row[0] & ~mask[0]) | (kValue & mask[0]);
+        row[1] = (row[1] & ~mask[1]) | (kValue & mask[1]);
+
+        row += 2;
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    for (uint32_t i = 0; is_dithering_ && (i < kBytes); i++) {
+        const auto* const kLevel = &level_[i * 8];
+
+        for (auto mask_ports = port_mask; mask_ports != 0; mask_ports &= (mask_ports - 1)) {
+            level_[i * 8 + static_cast<uint32_t>(__builtin_ctz(mask_ports))] = kLevel[port_index];
+        }
+    }
+#endif
+
+    port_mask_ |= static_cast<uint8_t>(port_mask);
+}
+
 void PixelOutputMulti::Blackout() {
     PIXEL_DEBUG_ENTRY();
 
     auto& pixel_configuration = PixelConfiguration::Get();
     const auto kType = pixel_configuration.GetType();
-    const auto kCount = pixel_configuration.GetCount();
 
     if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) {
         for (uint32_t port_index = 0; port_index < 8; port_index++) {
+            const auto kCount = pixel_configuration.GetPortCount(port_index);
+
             SetPixel4Bytes(port_index, 0, 0, 0, 0, 0);
 
             for (uint32_t nPixelIndex = 1; nPixelIndex <= kCount; nPixelIndex++) {
                 SetPixel4Bytes(port_index, nPixelIndex, 0, 0xE0, 0, 0);
             }
 
-            if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822)) {
-                SetPixel4Bytes(port_index, 1U + kCount, 0xFF, 0xFF, 0xFF, 0xFF);
-            } else {
-                SetPixel4Bytes(port_index, 1U + kCount, 0, 0, 0, 0);
-            }
+            SetEndFrame(port_index, kType, kCount);
         }
     } else {
-        memset(kPixelDatabuffer, 0, buffer_size_);
+        memset(staging_, 0, buffer_size_ & ~7U);
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        memset(level_, 0, (buffer_size_ & ~7U) * sizeof(level_[0]));
+        memset(error_, 0, buffer_size_ & ~7U);
+#endif
+        port_mask_ = 0;
     }
 
-    // Can be called any time.
-    do {
-        asm volatile("isb" ::: "memory");
-    } while (H3SpiDmaTxIsActive());
-
     Update();
 
-    // May not be interrupted.
-    do {
-        asm volatile("isb" ::: "memory");
-    } while (H3SpiDmaTxIsActive());
-
     PIXEL_DEBUG_EXIT();
 }
 
@@ -127,45 +251,133 @@ void PixelOutputMulti::FullOn() {
     auto& pixel_configuration = PixelConfiguration::Get();
 
     const auto kType = pixel_configuration.GetType();
-    const auto kCount = pixel_configuration.GetCount();
 
     if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) {
         for (uint32_t port_index = 0; port_index < 8; port_index++) {
+            const auto kCount = pixel_configuration.GetPortCount(port_index);
+
             SetPixel4Bytes(port_index, 0, 0, 0, 0, 0);
 
             for (uint32_t pixel_index = 1; pixel_index <= kCount; pixel_index++) {
                 SetPixel4Bytes(port_index, pixel_index, 0xFF, 0xE0, 0xFF, 0xFF);
             }
 
-            if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822)) {
-                SetPixel4Bytes(port_index, 1U + kCount, 0xFF, 0xFF, 0xFF, 0xFF);
-            } else {
-                SetPixel4Bytes(port_index, 1U + kCount, 0, 0, 0, 0);
+            SetEndFrame(port_index, kType, kCount);
+        }
+    } else {
+        const auto kLedsPerPixel = pixel_configuration.GetLedsPerPixel();
+
+        for (uint32_t port_index = 0; port_index < 8; port_index++) {
+            // The pixels after the count of a shorter port stay off
+            const auto kEnd = pixel_configuration.GetPortCount(port_index) * kLedsPerPixel * 8;
+
+            for (uint32_t i = port_index; i < kEnd; i += 8) {
+                staging_[i] = 0xFF;
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+                level_[i] = 0xFFFF;
+#endif
             }
         }
+
+        port_mask_ = 0xFF;
+    }
+
+    Update();
+
+    PIXEL_DEBUG_EXIT();
+}
+
+/**
+ * A shorter port is padded with 0 up to the longest port, which are clock
+ * edges for the end frame and a start frame for the pixels.
+ */
+void PixelOutputMulti::SetEndFrame(uint32_t port_index, pixel::LedType type, uint32_t count) {
+    if ((type == pixel::LedType::kAPA102) || (type == pixel::LedType::kSK9822)) {
+        SetPixel4Bytes(port_index, 1U + count, 0xFF, 0xFF, 0xFF, 0xFF);
     } else {
-        memset(kPixelDatabuffer, 0xFF, buffer_size_);
+        SetPixel4Bytes(port_index, 1U + count, 0, 0, 0, 0);
     }
 
-    // Can be called any time.
-    do {
-        asm volatile("isb" ::: "memory");
-    } while (H3SpiDmaTxIsActive());
+    const auto kMaxCount = PixelConfiguration::Get().GetMaxPortCount();
 
-    Update();
+    for (auto pixel_index = 2U + count; pixel_index <= 1U + kMaxCount; pixel_index++) {
+        SetPixel4Bytes(port_index, pixel_index, 0, 0, 0, 0);
+    }
+}
 
-    // May not be interrupted.
-    do {
-        asm volatile("isb" ::: "memory");
-    } while (H3SpiDmaTxIsActive());
+void PixelOutputMulti::Run() {
+    if (H3SpiDmaTxIsActive()) {
+        return;
+    }
 
-    PIXEL_DEBUG_EXIT();
+    if (is_update_pending_) {
+        Update();
+        return;
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    // The output only changes between the frames when a level has a fraction
+    if (has_fraction_) {
+        Update();
+    }
+#endif
 }
 
 uint32_t PixelOutputMulti::GetUserData() {
     return sv_nUpdatesPerSecond;
 }
 
+/**
+ * The tables of a matrix are compiled from the gamma, a port without a matrix has the fast path.
+ * The tables are allocated when a port gets a matrix, and kept when it is removed.
+ */
+void PixelOutputMulti::SetupMatrices() {
+    auto& pixel_configuration = PixelConfiguration::Get();
+
+    matrix_mask_ = 0;
+
+    for (uint32_t port_index = 0; port_index < std::min(8U, PixelConfiguration::kMaxPorts); port_index++) {
+        if (!pixel_configuration.HasPortMatrix(port_index)) {
+            continue;
+        }
+
+        if (matrix_[port_index] == nullptr) {
+            matrix_[port_index] = new pixel::ColourMatrix;
+        }
+
+        if (matrix_[port_index] != nullptr) {
+            matrix_[port_index]->Setup(pixel_configuration.GetPortMatrix(port_index), gamma16_);
+            matrix_mask_ |= static_cast<uint8_t>(1U << port_index);
+        }
+    }
+}
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+/**
+ * RTZ only: the levels have a fraction with a 16-bit input, a gamma curve or a colour matrix.
+ * Otherwise a level is a code times 257 and the dithering would not change the output.
+ */
+void PixelOutputMulti::SetupDithering() {
+    auto& pixel_configuration = PixelConfiguration::Get();
+
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+    const auto kIsGamma = pixel_configuration.IsEnableGammaCorrection() && (pixel_configuration.GetGammaTableValue() != pixel::dither::kLinear);
+#else
+    constexpr auto kIsGamma = false;
+#endif
+    const auto kIsDithering = pixel_configuration.IsRTZProtocol() && (is_input_16bit_ || kIsGamma || (matrix_mask_ != 0));
+
+    if (kIsDithering != is_dithering_) {
+        is_dithering_ = kIsDithering;
+        has_fraction_ = false;
+        memset(level_, 0, sizeof(level_));
+        memset(error_, 0, sizeof(error_));
+    }
+
+    PIXEL_DEBUG_PRINTF("is_dithering_=%d", is_dithering_);
+}
+#endif
+
 void PixelOutputMulti::ApplyConfiguration() {
     PIXEL_DEBUG_ENTRY();
 
@@ -173,12 +385,24 @@ void PixelOutputMulti::ApplyConfiguration() {
 
     pixel_configuration.Validate();
 
+    // The gamma and the colour matrices can change without a refresh
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+    pixel::dither::SetupGamma(gamma16_, pixel_configuration.IsEnableGammaCorrection() ? pixel_configuration.GetGammaTableValue() : pixel::dither::kLinear);
+#else
+    pixel::dither::SetupGamma(gamma16_, pixel::dither::kLinear);
+#endif
+    SetupMatrices();
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    SetupDithering();
+#endif
+
     if (!pixel_configuration.RefreshNeeded()) {
         PIXEL_DEBUG_EXIT();
         return;
     }
 
-    const auto kCount = pixel_configuration.GetCount();
+    // The transfer ends after the longest port
+    const auto kCount = pixel_configuration.GetMaxPortCount();
     buffer_size_ = kCount * pixel_configuration.GetLedsPerPixel();
 
     const auto kType = pixel_configuration.GetType();
@@ -209,8 +433,28 @@ void PixelOutputMulti::ApplyConfiguration() {
 
     buffer_size_++;
 
+    // The DMA buffer is set up again
+    do {
+        asm volatile("isb" ::: "memory");
+    } while (H3SpiDmaTxIsActive());
+
+    is_update_pending_ = false;
+
     SetupBuffers();
 
+    // A port can be shorter than before
+    memset(staging_, 0, sizeof(staging_));
+
+    for (uint32_t port_index = 0; port_index < 8; port_index++) {
+        mirror_mask_[port_index] = (port_index < PixelConfiguration::kMaxPorts) ? static_cast<uint8_t>(pixel_configuration.GetPortMirrorMask(port_index)) : 0;
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    has_fraction_ = false;
+    memset(level_, 0, sizeof(level_));
+    memset(error_, 0, sizeof(error_));
+#endif
+
     sv_nUpdatesPerSecond = 0;
     sv_nUpdatesPrevious = 0;
     sv_nUpdates = 0;
@@ -243,8 +487,21 @@ PixelOutputMulti::PixelOutputMulti() {
 }
 
 PixelOutputMulti::~PixelOutputMulti() {
+    do {
+        asm volatile("isb" ::: "memory");
+    } while (H3SpiDmaTxIsActive());
+
     Blackout();
 
+    do {
+        asm volatile("isb" ::: "memory");
+    } while (H3SpiDmaTxIsActive());
+
+    for (auto*& matrix : matrix_) {
+        delete matrix;
+        matrix = nullptr;
+    }
+
     dma_buffer_ = nullptr;
     s_this = nullptr;
 }
@@ -34,12 +34,30 @@
 
 #if defined(OUTPUT_DMX_PIXEL) || defined(OUTPUT_DMX_PIXEL_MULTI)
 #include "pixelconfiguration.h"
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+#include "pixelgovernor.h"
+#endif
 
 namespace json::status {
 uint32_t Pixel(char* out_buffer, uint32_t out_buffer_size) {
     auto& configuration = PixelConfiguration::Get();
     const auto kUserData = PixelOutputType::Get()->GetUserData();
 
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    const auto* const kGovernor = pixel::Governor::Get();
+
+    if (kGovernor != nullptr) {
+        return static_cast<uint32_t>(snprintf(out_buffer, out_buffer_size, 
+		"{\"refresh_rate\":\"%u\",\"frame_rate\":\"%u\",\"fps\":\"%u\",\"late_frames\":\"%u\",\"partial_frames\":\"%u\"}", 
+		static_cast<unsigned>(configuration.GetRefreshRate()), 
+		static_cast<unsigned>(kUserData),
+		static_cast<unsigned>(kGovernor->GetFps()),
+		static_cast<unsigned>(kGovernor->GetLateFrames()),
+		static_cast<unsigned>(kGovernor->GetPartialFrames()))
+	);
+    }
+#endif
+
     return static_cast<uint32_t>(snprintf(out_buffer, out_buffer_size, 
 		"{\"refresh_rate\":\"%u\",\"frame_rate\":\"%u\"}", 
 		static_cast<unsigned>(configuration.GetRefreshRate()), 
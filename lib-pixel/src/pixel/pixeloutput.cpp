@@ -26,122 +26,270 @@
 #pragma GCC push_options
 #pragma GCC optimize("O3")
 #pragma GCC optimize("-funroll-loops")
+#pragma GCC optimize("-fprefetch-loop-arrays")
 #endif
 
 #include <cstdint>
+#include <cstring>
 #include <cassert>
 
 #include "pixeloutput.h"
 #include "pixeltype.h"
 #include "pixelconfiguration.h"
+#include "pixelspidma.h"
+#include "pixel_debug.h"
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
 #include "gamma/gamma_tables.h"
 #endif
 
-void PixelOutput::SetColorWS28xx(uint32_t offset, uint8_t value) {
+PixelOutput::PixelOutput() {
+    PIXEL_DEBUG_ENTRY();
+
+    assert(s_this == nullptr);
+    s_this = this;
+
+    pixel::spidma::Begin();
+
+    ApplyConfiguration();
+
+    PIXEL_DEBUG_EXIT();
+}
+
+PixelOutput::~PixelOutput() {
+    PIXEL_DEBUG_ENTRY();
+
+    pixel::spidma::TxWait();
+
+    Blackout();
+
+    pixel::spidma::TxWait();
+
+    blackout_buffer_ = nullptr;
+    buffer_ = nullptr;
+    s_this = nullptr;
+
+    PIXEL_DEBUG_EXIT();
+}
+
+void PixelOutput::ApplyConfiguration() {
+    PIXEL_DEBUG_ENTRY();
+
     auto& pixel_configuration = PixelConfiguration::Get();
-    assert(pixel_configuration.GetType() != pixel::LedType::kWS2801);
-    assert(buffer_ != nullptr);
-    assert(offset + 7 < buf_size_);
+    pixel_configuration.Validate();
 
-    offset += 1;
+    // The gamma table can change without a refresh
+    SetupTable();
 
-    const auto kLowCode = pixel_configuration.GetLowCode();
-    const auto kHighCode = pixel_configuration.GetHighCode();
+    if (!pixel_configuration.RefreshNeeded()) {
+        PIXEL_DEBUG_EXIT();
+        return;
+    }
 
-    for (uint8_t mask = 0x80; mask != 0; mask = static_cast<uint8_t>(mask >> 1)) {
-        if (value & mask) {
-            buffer_[offset] = kHighCode;
+    // The buffers are set up again
+    pixel::spidma::TxWait();
+
+    pending_ = Pending::kNone;
+
+    pixel::spidma::SetSpeedHz(pixel_configuration.GetClockSpeedHz());
+
+    const auto kCount = pixel_configuration.GetCount();
+
+    buf_size_ = kCount * pixel_configuration.GetLedsPerPixel();
+
+    if (pixel_configuration.IsRTZProtocol()) {
+        buf_size_ *= 8;
+        buf_size_ += 1;
+    }
+
+    const auto kType = pixel_configuration.GetType();
+
+    if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) {
+        buf_size_ += kCount;
+        buf_size_ += 8;
+    }
+
+    SetupBuffers();
+
+    if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) {
+        memset(buffer_, 0, 4);
+
+        for (uint32_t pixel_index = 0; pixel_index < kCount; pixel_index++) {
+            SetPixel(pixel_index, 0, 0, 0);
+        }
+
+        if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822)) {
+            memset(&buffer_[buf_size_ - 4], 0xFF, 4);
         } else {
-            buffer_[offset] = kLowCode;
+            memset(&buffer_[buf_size_ - 4], 0, 4);
         }
-        offset++;
+    } else {
+        buffer_[0] = 0x00;
+        memset(&buffer_[1], kType == pixel::LedType::kWS2801 ? 0 : pixel_configuration.GetLowCode(), buf_size_);
     }
+
+    memcpy(blackout_buffer_, buffer_, buf_size_);
+    memcpy(buffers_[1], buffer_, buf_size_);
+
+    pixel_configuration.RefreshNeededReset();
+
+    PIXEL_DEBUG_EXIT();
 }
 
-void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue) {
-    auto& pixel_configuration = PixelConfiguration::Get();
-    assert(pixel_index < pixel_configuration.GetCount());
+void PixelOutput::SetupBuffers() {
+    PIXEL_DEBUG_ENTRY();
 
-#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
-    const auto* gamma_table = pixel_configuration.GetGammaTable();
+    uint32_t size;
 
-    red = gamma_table[red];
-    green = gamma_table[green];
-    blue = gamma_table[blue];
-#endif
+    auto* buffer = pixel::spidma::TxPrepare(&size);
+    assert(buffer != nullptr);
 
-    if (pixel_configuration.IsRTZProtocol()) {
-        const auto kOffset = pixel_index * 24U;
+    // Two frames that are composed and sent in turn, and the blackout frame
+    const auto kSizeQuarter = (size / 4) & static_cast<uint32_t>(~3);
 
-        SetColorWS28xx(kOffset, red);
-        SetColorWS28xx(kOffset + 8, green);
-        SetColorWS28xx(kOffset + 16, blue);
-        return;
-    }
+    PIXEL_DEBUG_PRINTF("buf_size_=%u, kSizeQuarter=%u", buf_size_, kSizeQuarter);
 
-    assert(buffer_ != nullptr);
+    assert(buf_size_ <= kSizeQuarter);
 
-    const auto kType = pixel_configuration.GetType();
+    buffers_[0] = buffer;
+    buffers_[1] = buffer + kSizeQuarter;
+    blackout_buffer_ = buffer + 2 * kSizeQuarter;
+    buffer_ = buffers_[0];
 
-    if (kType == pixel::LedType::kWS2801) {
-        const auto kOffset = pixel_index * 3U;
-        assert(kOffset + 2U < buf_size_);
+    PIXEL_DEBUG_PRINTF("size=%u, buffers_[0]=%p, buffers_[1]=%p, blackout_buffer_=%p", size, buffers_[0], buffers_[1], blackout_buffer_);
 
-        buffer_[kOffset] = red;
-        buffer_[kOffset + 1] = green;
-        buffer_[kOffset + 2] = blue;
+    PIXEL_DEBUG_EXIT();
+}
 
+void PixelOutput::Update() {
+    if (pixel::spidma::TxIsActive()) {
+        pending_ = Pending::kUpdate;
         return;
     }
 
-    if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822)) {
-        const auto kOffset = 4U + (pixel_index * 4U);
-        assert(kOffset + 3U < buf_size_);
+    pending_ = Pending::kNone;
 
-        buffer_[kOffset] = pixel_configuration.GetGlobalBrightness();
-        buffer_[kOffset + 1] = red;
-        buffer_[kOffset + 2] = green;
-        buffer_[kOffset + 3] = blue;
+    pixel::spidma::TxStart(buffer_, buf_size_);
 
+    // The next frame is composed in the other buffer, starting from the frame that is sent
+    const auto* const kSent = buffer_;
+    buffer_ = (buffer_ == buffers_[0]) ? buffers_[1] : buffers_[0];
+    memcpy(buffer_, kSent, buf_size_);
+}
+
+/**
+ * The blackout frame is prepared by ApplyConfiguration, the composed frame is kept.
+ */
+void PixelOutput::Blackout() {
+    PIXEL_DEBUG_ENTRY();
+
+    if (pixel::spidma::TxIsActive()) {
+        pending_ = Pending::kBlackout;
+        PIXEL_DEBUG_EXIT();
         return;
     }
 
-    if (kType == pixel::LedType::kP9813) {
-        const auto kOffset = 4U + (pixel_index * 4U);
-        assert(kOffset + 3 < buf_size_);
+    pending_ = Pending::kNone;
+
+    pixel::spidma::TxStart(blackout_buffer_, buf_size_);
+
+    PIXEL_DEBUG_EXIT();
+}
+
+void PixelOutput::FullOn() {
+    PIXEL_DEBUG_ENTRY();
+
+    auto& pixel_configuration = PixelConfiguration::Get();
+
+    const auto kType = pixel_configuration.GetType();
+    const auto kCount = pixel_configuration.GetCount();
+
+    if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822) || (kType == pixel::LedType::kP9813)) {
+        memset(buffer_, 0xFF, 4);
+
+        for (uint32_t pixel_index = 0; pixel_index < kCount; pixel_index++) {
+            SetPixel(pixel_index, 0xFF, 0xFF, 0xFF);
+        }
+
+        if ((kType == pixel::LedType::kAPA102) || (kType == pixel::LedType::kSK9822)) {
+            memset(&buffer_[buf_size_ - 4], 0xFF, 4);
+        } else {
+            memset(&buffer_[buf_size_ - 4], 0, 4);
+        }
+    } else {
+        buffer_[0] = 0x00;
+        memset(&buffer_[1], kType == pixel::LedType::kWS2801 ? 0xFF : pixel_configuration.GetHighCode(), buf_size_);
+    }
 
-        const auto kFlag = static_cast<uint8_t>(0xC0 | ((~blue & 0xC0) >> 2) | ((~green & 0xC0) >> 4) | ((~red & 0xC0) >> 6));
+    Update();
 
-        buffer_[kOffset] = kFlag;
-        buffer_[kOffset + 1] = blue;
-        buffer_[kOffset + 2] = green;
-        buffer_[kOffset + 3] = red;
+    PIXEL_DEBUG_EXIT();
+}
 
+void PixelOutput::Run() {
+    if ((pending_ == Pending::kNone) || pixel::spidma::TxIsActive()) {
         return;
     }
 
-    assert(0);
-    __builtin_unreachable();
+    if (pending_ == Pending::kBlackout) {
+        Blackout();
+    } else {
+        Update();
+    }
 }
 
-void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
-    assert(pixel_index < PixelConfiguration::Get().GetCount());
-    assert(PixelConfiguration::Get().GetType() == pixel::LedType::kSK6812W);
+void PixelOutput::SetupTable() {
+    auto& pixel_configuration = PixelConfiguration::Get();
+
+    if (!pixel_configuration.IsRTZProtocol()) {
+        return;
+    }
 
+    const auto kLowCode = pixel_configuration.GetLowCode();
+    const auto kHighCode = pixel_configuration.GetHighCode();
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
-    const auto* gamma_table = PixelConfiguration::Get().GetGammaTable();
+    const auto* gamma_table = pixel_configuration.GetGammaTable();
+#endif
 
-    red = gamma_table[red];
-    green = gamma_table[green];
-    blue = gamma_table[blue];
-    white = gamma_table[white];
+    for (uint32_t value = 0; value < 256; value++) {
+#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
+        const auto kValue = gamma_table[value];
+#else
+        const auto kValue = value;
 #endif
+        for (uint32_t bit = 0; bit < 8; bit++) {
+            table_[value][bit] = (kValue & (0x80U >> bit)) ? kHighCode : kLowCode;
+        }
+    }
+}
+
+void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue) {
+    switch (pixel::GetFamily(PixelConfiguration::Get().GetType())) {
+        case pixel::LedFamily::kRtz:
+            SetPixel<pixel::LedFamily::kRtz>(pixel_index, red, green, blue);
+            return;
+        case pixel::LedFamily::kWS2801:
+            SetPixel<pixel::LedFamily::kWS2801>(pixel_index, red, green, blue);
+            return;
+        case pixel::LedFamily::kAPA102:
+            SetPixel<pixel::LedFamily::kAPA102>(pixel_index, red, green, blue);
+            return;
+        case pixel::LedFamily::kP9813:
+            SetPixel<pixel::LedFamily::kP9813>(pixel_index, red, green, blue);
+            return;
+        case pixel::LedFamily::kRtzRgbw:
+            SetPixel(pixel_index, red, green, blue, 0);
+            return;
+        default:
+            break;
+    }
 
-    const auto kOffset = pixel_index * 32U;
+    assert(0);
+    __builtin_unreachable();
+}
+
+void PixelOutput::SetPixel(uint32_t pixel_index, uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
+    assert(PixelConfiguration::Get().GetType() == pixel::LedType::kSK6812W);
 
-    SetColorWS28xx(kOffset, green);
-    SetColorWS28xx(kOffset + 8, red);
-    SetColorWS28xx(kOffset + 16, blue);
-    SetColorWS28xx(kOffset + 24, white);
+    const uint8_t kColours[4] = {red, green, blue, white};
+    SetPixels<pixel::LedFamily::kRtzRgbw, 0>(pixel_index, kColours, 1);
 }
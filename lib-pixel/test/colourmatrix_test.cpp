@@ -0,0 +1,122 @@
+/**
+ * @file colourmatrix_test.cpp
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Host test of the colour matrix of the multi-port output. A store written by
+ * a firmware without the matrix is erased (0xFF), which must be no matrix.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "configurationstore.h"
+#include "pixelconfiguration.h"
+#include "pixelcolourmatrix.h"
+#include "pixeldither.h"
+
+static uint32_t s_errors;
+
+static void Check(bool is_ok, const char* what) {
+    if (!is_ok) {
+        printf("FAILED: %s\n", what);
+        s_errors++;
+    }
+}
+
+static bool IsZero(const int8_t* coefficients) {
+    for (uint32_t i = 0; i < pixel::ColourMatrix::kCoefficients; i++) {
+        if (coefficients[i] != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * The section was added at the end of the store, after an upgrade it is erased
+ */
+static void TestUpgrade(PixelConfiguration& configuration) {
+    common::store::DmxLedMatrix store;
+    memset(&store, 0xFF, sizeof(store));
+
+    for (uint32_t i = 0; i < PixelConfiguration::kMaxPorts; i++) {
+        Check(!pixel::ColourMatrix::IsSet(store.coefficient[i]), "erased is set");
+        configuration.SetPortMatrix(i, store.coefficient[i]);
+        Check(!configuration.HasPortMatrix(i), "erased port has a matrix");
+        Check(IsZero(configuration.GetPortMatrix(i)), "erased port is not all zero");
+    }
+
+    memset(&store, 0, sizeof(store));
+    Check(!pixel::ColourMatrix::IsSet(store.coefficient[0]), "zero is set");
+
+    // A single -1 is a matrix
+    store.coefficient[0][3] = -1;
+    Check(pixel::ColourMatrix::IsSet(store.coefficient[0]), "-1 is not set");
+    configuration.SetPortMatrix(0, store.coefficient[0]);
+    Check(configuration.HasPortMatrix(0), "-1 port has no matrix");
+}
+
+static void TestLevels() {
+    static constexpr int8_t kIdentity[pixel::ColourMatrix::kCoefficients] = {100, 0, 0, 0, 100, 0, 0, 0, 100, 0, 0, 0};
+    static constexpr int8_t kWhite[pixel::ColourMatrix::kCoefficients] = {50, 0, 0, 0, 50, 0, 0, 0, 50, 100, 100, 100};
+
+    uint16_t gamma[256];
+    pixel::dither::SetupGamma(gamma, pixel::dither::kLinear);
+
+    static pixel::ColourMatrix matrix;
+    matrix.Setup(kIdentity, gamma);
+
+    for (uint32_t value = 0; value < 256; value++) {
+        const auto kValue = static_cast<uint8_t>(value);
+        Check(matrix.Level<0>(kValue, 0, 0) == gamma[value], "identity red");
+        Check(matrix.Level<1>(0, kValue, 0) == gamma[value], "identity green");
+        Check(matrix.Level<2>(0, 0, kValue) == gamma[value], "identity blue");
+        Check(pixel::ColourMatrix::Code(matrix.Level<0>(kValue, kValue, kValue)) == kValue, "identity code");
+    }
+
+    // The white is the sum of the colours, clamped, with the white of the DMX added
+    matrix.Setup(kWhite, gamma);
+    Check(matrix.Level<0>(0xFF, 0xFF, 0xFF) == 0x7FFF, "half red");
+    Check(matrix.LevelWhite(0x80, 0, 0, 0) == gamma[0x80], "white from red");
+    Check(matrix.LevelWhite(0xFF, 0xFF, 0, 0) == 0xFFFF, "white clamped");
+    Check(matrix.LevelWhite(0, 0, 0, 0x1234) == 0x1234, "white of the DMX");
+}
+
+int main() {
+    PixelConfiguration configuration;
+
+    TestUpgrade(configuration);
+    TestLevels();
+
+    if (s_errors != 0) {
+        printf("FAILED: %u errors\n", static_cast<unsigned>(s_errors));
+        return 1;
+    }
+
+    puts("ColourMatrix passed");
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file pixeloutput_test.cpp
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Host loopback test of PixelOutput on the lib-linux SPI TX DMA. The device is
+ * a regular file, spi::SetDevice, so the frames are appended to it as sent.
+ * Followed by a benchmark of the RTZ encoder in pixels per second.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "pixeloutput.h"
+#include "pixelconfiguration.h"
+#include "spi.h"
+
+static constexpr char kDevice[] = "pixeloutput_test.bin";
+static constexpr uint32_t kCount = 4;
+static constexpr uint32_t kFrameSize = 1 + (kCount * 3 * 8); // WS2812B
+
+static uint32_t s_errors;
+
+static void Check(bool is_ok, const char* what) {
+    if (!is_ok) {
+        printf("FAILED: %s\n", what);
+        s_errors++;
+    }
+}
+
+/**
+ * Until the frame that is sent and a deferred update are done
+ */
+static void Wait(PixelOutput& output) {
+    do {
+        while (output.IsUpdating()) {
+            std::this_thread::yield();
+        }
+
+        output.Run();
+    } while (output.IsUpdating());
+}
+
+/**
+ * All 24 codes of the pixel are the high code for 0xFF, the low code for 0x00.
+ * For 0x80 only the first code of each colour is high.
+ */
+static bool IsPixel(const uint8_t* frame, uint32_t pixel_index, uint8_t value) {
+    const auto& kConfiguration = PixelConfiguration::Get();
+    const auto* const kCodes = &frame[1 + (pixel_index * 24)];
+
+    for (uint32_t i = 0; i < 24; i++) {
+        const auto kIsHigh = (value & (0x80U >> (i % 8))) != 0;
+        if (kCodes[i] != (kIsHigh ? kConfiguration.GetHighCode() : kConfiguration.GetLowCode())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void TestLoopback() {
+    remove(kDevice);
+    fclose(fopen(kDevice, "w"));
+    spi::SetDevice(kDevice);
+
+    auto& configuration = PixelConfiguration::Get();
+    configuration.SetType(pixel::LedType::kWS2812B);
+    configuration.SetCount(kCount);
+
+    {
+        PixelOutput output;
+
+        output.SetPixel(0, 0xFF, 0xFF, 0xFF);
+        output.Update();
+        // Composed while the first frame can still be sent, then the update is deferred to Run
+        output.SetPixel(1, 0x80, 0x80, 0x80);
+        output.Update();
+        Wait(output);
+    } // The destructor sends the blackout frame
+
+    auto* file = fopen(kDevice, "rb");
+    std::vector<uint8_t> frames(4 * kFrameSize);
+    const auto kSize = fread(frames.data(), 1, frames.size(), file);
+    fclose(file);
+    remove(kDevice);
+
+    Check(kSize == 3 * kFrameSize, "three frames are sent");
+
+    if (kSize != 3 * kFrameSize) {
+        return;
+    }
+
+    const auto* const kFirst = &frames[0];
+    const auto* const kSecond = &frames[kFrameSize];
+    const auto* const kBlackout = &frames[2 * kFrameSize];
+
+    Check(IsPixel(kFirst, 0, 0xFF) && IsPixel(kFirst, 1, 0x00) && IsPixel(kFirst, 2, 0x00), "first frame");
+    Check(IsPixel(kSecond, 0, 0xFF) && IsPixel(kSecond, 1, 0x80) && IsPixel(kSecond, 3, 0x00), "second frame keeps the first");
+
+    for (uint32_t pixel_index = 0; pixel_index < kCount; pixel_index++) {
+        Check(IsPixel(kBlackout, pixel_index, 0x00), "blackout frame");
+    }
+}
+
+static void Benchmark(pixel::LedType type, const char* name) {
+    static constexpr uint32_t kPixels = 170; // A universe of RGB pixels
+    static constexpr uint32_t kRuns = 20000;
+
+    auto& configuration = PixelConfiguration::Get();
+    configuration.SetType(type);
+    configuration.SetCount(kPixels);
+
+    PixelOutput output;
+    const auto kIsRgbw = (type == pixel::LedType::kSK6812W);
+    const auto kStart = std::chrono::steady_clock::now();
+
+    for (uint32_t run = 0; run < kRuns; run++) {
+        const auto kValue = static_cast<uint8_t>(run);
+
+        for (uint32_t pixel_index = 0; pixel_index < kPixels; pixel_index++) {
+            if (kIsRgbw) {
+                output.SetPixel(pixel_index, kValue, static_cast<uint8_t>(pixel_index), 0x55, 0xAA);
+            } else {
+                output.SetPixel(pixel_index, kValue, static_cast<uint8_t>(pixel_index), 0x55);
+            }
+        }
+    }
+
+    const std::chrono::duration<double, std::micro> kElapsed = std::chrono::steady_clock::now() - kStart;
+    printf("%-8s: %.1f Mpixels/s\n", name, (static_cast<double>(kRuns) * kPixels) / kElapsed.count());
+}
+
+int main() {
+    PixelConfiguration configuration;
+
+    TestLoopback();
+
+    if (s_errors != 0) {
+        printf("FAILED: %u errors\n", static_cast<unsigned>(s_errors));
+        return 1;
+    }
+
+    puts("PixelOutput loopback passed");
+
+    spi::SetDevice("/dev/null");
+    Benchmark(pixel::LedType::kWS2812B, "WS2812B");
+    Benchmark(pixel::LedType::kSK6812W, "SK6812W");
+
+    return 0;
+}
@@ -32,6 +32,9 @@ else
 	DEFINES+=CONFIG_DMXNODE_PIXEL_MAX_PORTS=8
 	DEFINES+=DMXNODE_PORTS=32
 	DEFINES+=OUTPUT_DMX_PIXEL OUTPUT_DMX_PIXEL_MULTI
+	DEFINES+=CONFIG_PIXELDMX_ENABLE_INTERPOLATION
+	DEFINES+=CONFIG_PIXELDMX_ENABLE_DITHER
+	DEFINES+=CONFIG_PIXELDMX_ENABLE_GOVERNOR
 	DEFINES+=CONFIG_RDM_ENABLE_MANUFACTURER_PIDS CONFIG_RDM_MANUFACTURER_PIDS_SET
 	EXTRA_INCLUDES+=../lib-dmx/include ../lib-rdm/include
 	EXTRA_SRCDIR+=src/pixeldmxrdm
@@ -74,6 +74,21 @@ class PixelDmxParams : public JsonParamsBase<PixelDmxParams>
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)    
     static void SetGammaCorrection(const char* val, uint32_t len);
     static void SetGammaValue(const char* val, uint32_t len);
+#endif
+#if defined(OUTPUT_DMX_PIXEL_MULTI) && defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    static void SetInput16Bit(const char* val, uint32_t len);
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    static void SetFrameDeadline(const char* val, uint32_t len);
+#endif
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    static void SetCountPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len);
+    static void SetTypePort(const char* key, uint32_t key_len, const char* val, uint32_t val_len);
+    static void SetMirrorPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len);
+    static void SetMatrixPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len);
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    static void SetInterpolationPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len);
+#endif
 #endif
 
     static constexpr json::Key kPixelDmxKeys[] = {
@@ -85,6 +100,12 @@ class PixelDmxParams : public JsonParamsBase<PixelDmxParams>
 	MakeKey(SetHighCode, DmxLedParamsConst::kT1H),
 #if defined(OUTPUT_DMX_PIXEL_MULTI)
 	MakeKey(SetActiveOutputs, DmxLedParamsConst::kActiveOutputPorts),
+#endif
+#if defined(OUTPUT_DMX_PIXEL_MULTI) && defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+	MakeKey(SetInput16Bit, PixelDmxParamsConst::kInput16Bit),
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+	MakeKey(SetFrameDeadline, PixelDmxParamsConst::kFrameDeadline),
 #endif
 	MakeKey(SetTestPattern, DmxLedParamsConst::kTestPattern),
 	MakeKey(SetSpiSpeedHz, DmxLedParamsConst::kSpiSpeedHz),
@@ -109,6 +130,98 @@ class PixelDmxParams : public JsonParamsBase<PixelDmxParams>
 	MakeKey(SetStartUniPort, PixelDmxParamsConst::kStartUniPort[14]),
 	MakeKey(SetStartUniPort, PixelDmxParamsConst::kStartUniPort[15]),
 #endif
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[0]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[0]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[0]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[0]),
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[0]),
+#endif
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[1]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[2]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[3]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[4]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[5]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[6]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[7]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[1]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[2]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[3]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[4]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[5]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[6]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[7]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[1]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[2]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[3]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[4]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[5]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[6]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[7]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[1]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[2]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[3]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[4]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[5]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[6]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[7]),
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[1]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[2]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[3]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[4]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[5]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[6]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[7]),
+#endif
+#endif
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[8]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[9]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[10]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[11]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[12]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[13]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[14]),
+	MakeKey(SetCountPort, PixelDmxParamsConst::kCountPort[15]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[8]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[9]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[10]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[11]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[12]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[13]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[14]),
+	MakeKey(SetTypePort, PixelDmxParamsConst::kTypePort[15]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[8]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[9]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[10]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[11]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[12]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[13]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[14]),
+	MakeKey(SetMirrorPort, PixelDmxParamsConst::kMirrorPort[15]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[8]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[9]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[10]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[11]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[12]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[13]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[14]),
+	MakeKey(SetMatrixPort, PixelDmxParamsConst::kMatrixPort[15]),
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[8]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[9]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[10]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[11]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[12]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[13]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[14]),
+	MakeKey(SetInterpolationPort, PixelDmxParamsConst::kInterpolationPort[15]),
+#endif
+#endif
+#endif
 #if defined(RDM_RESPONDER)
 	MakeKey(SetDmxStartAddress, PixelDmxParamsConst::kDmxStartAddress),
 #endif
@@ -119,6 +232,10 @@ class PixelDmxParams : public JsonParamsBase<PixelDmxParams>
     };
 
     inline static common::store::DmxLed store_dmxled;
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    inline static common::store::DmxLedPorts store_dmxled_ports;
+    inline static common::store::DmxLedMatrix store_dmxled_matrix;
+#endif
 
     friend class JsonParamsBase<PixelDmxParams>;
 };
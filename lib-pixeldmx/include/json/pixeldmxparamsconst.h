@@ -32,6 +32,8 @@
 namespace json {
 struct PixelDmxParamsConst {
     static constexpr auto kDmxStartAddress = json::MakeSimpleKey("dmx_start_address");
+    static constexpr auto kInput16Bit = json::MakeSimpleKey("input_16bit");
+    static constexpr auto kFrameDeadline = json::MakeSimpleKey("frame_deadline_ms");
 
     static constexpr auto kDmxSlotInfo = json::MakeSimpleKey("dmx_slot_info");
     static constexpr json::PortKey kStartUniPort1{"start_uni_port_1", 16, Fnv1a32("start_uni_port_1", 16)};
@@ -64,6 +66,154 @@ struct PixelDmxParamsConst {
 #endif
 #endif
     };
+
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    static constexpr json::PortKey kCountPort1{"count_port_1", 12, Fnv1a32("count_port_1", 12)};
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+    static constexpr json::PortKey kCountPort2{"count_port_2", 12, Fnv1a32("count_port_2", 12)};
+    static constexpr json::PortKey kCountPort3{"count_port_3", 12, Fnv1a32("count_port_3", 12)};
+    static constexpr json::PortKey kCountPort4{"count_port_4", 12, Fnv1a32("count_port_4", 12)};
+    static constexpr json::PortKey kCountPort5{"count_port_5", 12, Fnv1a32("count_port_5", 12)};
+    static constexpr json::PortKey kCountPort6{"count_port_6", 12, Fnv1a32("count_port_6", 12)};
+    static constexpr json::PortKey kCountPort7{"count_port_7", 12, Fnv1a32("count_port_7", 12)};
+    static constexpr json::PortKey kCountPort8{"count_port_8", 12, Fnv1a32("count_port_8", 12)};
+#endif
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+    static constexpr json::PortKey kCountPort9{"count_port_9", 12, Fnv1a32("count_port_9", 12)};
+    static constexpr json::PortKey kCountPort10{"count_port_10", 13, Fnv1a32("count_port_10", 13)};
+    static constexpr json::PortKey kCountPort11{"count_port_11", 13, Fnv1a32("count_port_11", 13)};
+    static constexpr json::PortKey kCountPort12{"count_port_12", 13, Fnv1a32("count_port_12", 13)};
+    static constexpr json::PortKey kCountPort13{"count_port_13", 13, Fnv1a32("count_port_13", 13)};
+    static constexpr json::PortKey kCountPort14{"count_port_14", 13, Fnv1a32("count_port_14", 13)};
+    static constexpr json::PortKey kCountPort15{"count_port_15", 13, Fnv1a32("count_port_15", 13)};
+    static constexpr json::PortKey kCountPort16{"count_port_16", 13, Fnv1a32("count_port_16", 13)};
+#endif
+
+    static constexpr json::PortKey kTypePort1{"type_port_1", 11, Fnv1a32("type_port_1", 11)};
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+    static constexpr json::PortKey kTypePort2{"type_port_2", 11, Fnv1a32("type_port_2", 11)};
+    static constexpr json::PortKey kTypePort3{"type_port_3", 11, Fnv1a32("type_port_3", 11)};
+    static constexpr json::PortKey kTypePort4{"type_port_4", 11, Fnv1a32("type_port_4", 11)};
+    static constexpr json::PortKey kTypePort5{"type_port_5", 11, Fnv1a32("type_port_5", 11)};
+    static constexpr json::PortKey kTypePort6{"type_port_6", 11, Fnv1a32("type_port_6", 11)};
+    static constexpr json::PortKey kTypePort7{"type_port_7", 11, Fnv1a32("type_port_7", 11)};
+    static constexpr json::PortKey kTypePort8{"type_port_8", 11, Fnv1a32("type_port_8", 11)};
+#endif
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+    static constexpr json::PortKey kTypePort9{"type_port_9", 11, Fnv1a32("type_port_9", 11)};
+    static constexpr json::PortKey kTypePort10{"type_port_10", 12, Fnv1a32("type_port_10", 12)};
+    static constexpr json::PortKey kTypePort11{"type_port_11", 12, Fnv1a32("type_port_11", 12)};
+    static constexpr json::PortKey kTypePort12{"type_port_12", 12, Fnv1a32("type_port_12", 12)};
+    static constexpr json::PortKey kTypePort13{"type_port_13", 12, Fnv1a32("type_port_13", 12)};
+    static constexpr json::PortKey kTypePort14{"type_port_14", 12, Fnv1a32("type_port_14", 12)};
+    static constexpr json::PortKey kTypePort15{"type_port_15", 12, Fnv1a32("type_port_15", 12)};
+    static constexpr json::PortKey kTypePort16{"type_port_16", 12, Fnv1a32("type_port_16", 12)};
+#endif
+
+    static constexpr json::PortKey kMirrorPort1{"mirror_port_1", 13, Fnv1a32("mirror_port_1", 13)};
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+    static constexpr json::PortKey kMirrorPort2{"mirror_port_2", 13, Fnv1a32("mirror_port_2", 13)};
+    static constexpr json::PortKey kMirrorPort3{"mirror_port_3", 13, Fnv1a32("mirror_port_3", 13)};
+    static constexpr json::PortKey kMirrorPort4{"mirror_port_4", 13, Fnv1a32("mirror_port_4", 13)};
+    static constexpr json::PortKey kMirrorPort5{"mirror_port_5", 13, Fnv1a32("mirror_port_5", 13)};
+    static constexpr json::PortKey kMirrorPort6{"mirror_port_6", 13, Fnv1a32("mirror_port_6", 13)};
+    static constexpr json::PortKey kMirrorPort7{"mirror_port_7", 13, Fnv1a32("mirror_port_7", 13)};
+    static constexpr json::PortKey kMirrorPort8{"mirror_port_8", 13, Fnv1a32("mirror_port_8", 13)};
+#endif
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+    static constexpr json::PortKey kMirrorPort9{"mirror_port_9", 13, Fnv1a32("mirror_port_9", 13)};
+    static constexpr json::PortKey kMirrorPort10{"mirror_port_10", 14, Fnv1a32("mirror_port_10", 14)};
+    static constexpr json::PortKey kMirrorPort11{"mirror_port_11", 14, Fnv1a32("mirror_port_11", 14)};
+    static constexpr json::PortKey kMirrorPort12{"mirror_port_12", 14, Fnv1a32("mirror_port_12", 14)};
+    static constexpr json::PortKey kMirrorPort13{"mirror_port_13", 14, Fnv1a32("mirror_port_13", 14)};
+    static constexpr json::PortKey kMirrorPort14{"mirror_port_14", 14, Fnv1a32("mirror_port_14", 14)};
+    static constexpr json::PortKey kMirrorPort15{"mirror_port_15", 14, Fnv1a32("mirror_port_15", 14)};
+    static constexpr json::PortKey kMirrorPort16{"mirror_port_16", 14, Fnv1a32("mirror_port_16", 14)};
+#endif
+
+    static constexpr json::PortKey kMatrixPort1{"matrix_port_1", 13, Fnv1a32("matrix_port_1", 13)};
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+    static constexpr json::PortKey kMatrixPort2{"matrix_port_2", 13, Fnv1a32("matrix_port_2", 13)};
+    static constexpr json::PortKey kMatrixPort3{"matrix_port_3", 13, Fnv1a32("matrix_port_3", 13)};
+    static constexpr json::PortKey kMatrixPort4{"matrix_port_4", 13, Fnv1a32("matrix_port_4", 13)};
+    static constexpr json::PortKey kMatrixPort5{"matrix_port_5", 13, Fnv1a32("matrix_port_5", 13)};
+    static constexpr json::PortKey kMatrixPort6{"matrix_port_6", 13, Fnv1a32("matrix_port_6", 13)};
+    static constexpr json::PortKey kMatrixPort7{"matrix_port_7", 13, Fnv1a32("matrix_port_7", 13)};
+    static constexpr json::PortKey kMatrixPort8{"matrix_port_8", 13, Fnv1a32("matrix_port_8", 13)};
+#endif
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+    static constexpr json::PortKey kMatrixPort9{"matrix_port_9", 13, Fnv1a32("matrix_port_9", 13)};
+    static constexpr json::PortKey kMatrixPort10{"matrix_port_10", 14, Fnv1a32("matrix_port_10", 14)};
+    static constexpr json::PortKey kMatrixPort11{"matrix_port_11", 14, Fnv1a32("matrix_port_11", 14)};
+    static constexpr json::PortKey kMatrixPort12{"matrix_port_12", 14, Fnv1a32("matrix_port_12", 14)};
+    static constexpr json::PortKey kMatrixPort13{"matrix_port_13", 14, Fnv1a32("matrix_port_13", 14)};
+    static constexpr json::PortKey kMatrixPort14{"matrix_port_14", 14, Fnv1a32("matrix_port_14", 14)};
+    static constexpr json::PortKey kMatrixPort15{"matrix_port_15", 14, Fnv1a32("matrix_port_15", 14)};
+    static constexpr json::PortKey kMatrixPort16{"matrix_port_16", 14, Fnv1a32("matrix_port_16", 14)};
+#endif
+
+    static constexpr json::PortKey kInterpolationPort1{"interpolation_port_1", 20, Fnv1a32("interpolation_port_1", 20)};
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+    static constexpr json::PortKey kInterpolationPort2{"interpolation_port_2", 20, Fnv1a32("interpolation_port_2", 20)};
+    static constexpr json::PortKey kInterpolationPort3{"interpolation_port_3", 20, Fnv1a32("interpolation_port_3", 20)};
+    static constexpr json::PortKey kInterpolationPort4{"interpolation_port_4", 20, Fnv1a32("interpolation_port_4", 20)};
+    static constexpr json::PortKey kInterpolationPort5{"interpolation_port_5", 20, Fnv1a32("interpolation_port_5", 20)};
+    static constexpr json::PortKey kInterpolationPort6{"interpolation_port_6", 20, Fnv1a32("interpolation_port_6", 20)};
+    static constexpr json::PortKey kInterpolationPort7{"interpolation_port_7", 20, Fnv1a32("interpolation_port_7", 20)};
+    static constexpr json::PortKey kInterpolationPort8{"interpolation_port_8", 20, Fnv1a32("interpolation_port_8", 20)};
+#endif
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+    static constexpr json::PortKey kInterpolationPort9{"interpolation_port_9", 20, Fnv1a32("interpolation_port_9", 20)};
+    static constexpr json::PortKey kInterpolationPort10{"interpolation_port_10", 21, Fnv1a32("interpolation_port_10", 21)};
+    static constexpr json::PortKey kInterpolationPort11{"interpolation_port_11", 21, Fnv1a32("interpolation_port_11", 21)};
+    static constexpr json::PortKey kInterpolationPort12{"interpolation_port_12", 21, Fnv1a32("interpolation_port_12", 21)};
+    static constexpr json::PortKey kInterpolationPort13{"interpolation_port_13", 21, Fnv1a32("interpolation_port_13", 21)};
+    static constexpr json::PortKey kInterpolationPort14{"interpolation_port_14", 21, Fnv1a32("interpolation_port_14", 21)};
+    static constexpr json::PortKey kInterpolationPort15{"interpolation_port_15", 21, Fnv1a32("interpolation_port_15", 21)};
+    static constexpr json::PortKey kInterpolationPort16{"interpolation_port_16", 21, Fnv1a32("interpolation_port_16", 21)};
+#endif
+
+    static constexpr json::PortKey kCountPort[] = {kCountPort1,
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+                                                  kCountPort2, kCountPort3, kCountPort4, kCountPort5, kCountPort6, kCountPort7, kCountPort8,
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+                                                  kCountPort9, kCountPort10, kCountPort11, kCountPort12, kCountPort13, kCountPort14, kCountPort15, kCountPort16
+#endif
+#endif
+    };
+    static constexpr json::PortKey kTypePort[] = {kTypePort1,
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+                                                  kTypePort2, kTypePort3, kTypePort4, kTypePort5, kTypePort6, kTypePort7, kTypePort8,
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+                                                  kTypePort9, kTypePort10, kTypePort11, kTypePort12, kTypePort13, kTypePort14, kTypePort15, kTypePort16
+#endif
+#endif
+    };
+    static constexpr json::PortKey kMirrorPort[] = {kMirrorPort1,
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+                                                    kMirrorPort2, kMirrorPort3, kMirrorPort4, kMirrorPort5, kMirrorPort6, kMirrorPort7, kMirrorPort8,
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+                                                    kMirrorPort9, kMirrorPort10, kMirrorPort11, kMirrorPort12, kMirrorPort13, kMirrorPort14, kMirrorPort15, kMirrorPort16
+#endif
+#endif
+    };
+    static constexpr json::PortKey kMatrixPort[] = {kMatrixPort1,
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+                                                    kMatrixPort2, kMatrixPort3, kMatrixPort4, kMatrixPort5, kMatrixPort6, kMatrixPort7, kMatrixPort8,
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+                                                    kMatrixPort9, kMatrixPort10, kMatrixPort11, kMatrixPort12, kMatrixPort13, kMatrixPort14, kMatrixPort15, kMatrixPort16
+#endif
+#endif
+    };
+    static constexpr json::PortKey kInterpolationPort[] = {kInterpolationPort1,
+#if (CONFIG_DMXNODE_PIXEL_MAX_PORTS > 1)
+                                                           kInterpolationPort2, kInterpolationPort3, kInterpolationPort4, kInterpolationPort5, kInterpolationPort6, kInterpolationPort7, kInterpolationPort8,
+#if CONFIG_DMXNODE_PIXEL_MAX_PORTS == 16
+                                                           kInterpolationPort9, kInterpolationPort10, kInterpolationPort11, kInterpolationPort12, kInterpolationPort13, kInterpolationPort14, kInterpolationPort15, kInterpolationPort16
+#endif
+#endif
+    };
+#endif
 };
 } // namespace json
 
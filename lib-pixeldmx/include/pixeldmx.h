@@ -49,6 +49,10 @@
 #include "gpio.h"
 #endif
 #include "dmxnode.h"
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+#include "pixelgovernor.h"
+#include "timing.h"
+#endif
 #include "firmware/debug/debug_debug.h"
 
 #if defined(OUTPUT_DMX_PIXEL) && defined(RDM_RESPONDER) && !defined(NODE_ARTNET)
@@ -94,6 +98,17 @@ class PixelDmx final : public PixelDmxConfiguration {
         output_type_.ApplyConfiguration();
         output_type_.Blackout();
 
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+        governor_.Reset();
+
+        for (uint32_t index = 0; index <= PixelDmxConfiguration::GetPortInfo().protocol_port_index_last; index++) {
+            governor_.SetExpected(index);
+        }
+
+        governor_.SetDeadlineMillis(PixelDmxConfiguration::GetFrameDeadlineMillis());
+        governor_.SetRefreshRate(PixelConfiguration::GetRefreshRate());
+#endif
+
         DEBUG_EXIT();
     }
 
@@ -132,11 +147,6 @@ class PixelDmx final : public PixelDmxConfiguration {
         assert(data != nullptr);
         assert(length <= dmxnode::kUniverseSize);
 
-        if (output_type_.IsUpdating()) {
-            puts("output_type_.IsUpdating()");
-            return;
-        }
-
         auto& port_info = PixelDmxConfiguration::GetPortInfo();
         uint32_t d = 0;
 
@@ -161,78 +171,12 @@ class PixelDmx final : public PixelDmxConfiguration {
 
         const auto kGroupingCount = PixelDmxConfiguration::GetGroupingCount();
 
-        if (kChannelsPerPixel == 3) {
-            switch (PixelDmxConfiguration::GetMap()) {
-                case pixel::LedMap::kRGB:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 0], data[d + 1], data[d + 2]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kRBG:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 0], data[d + 2], data[d + 1]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kGRB:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 1], data[d + 0], data[d + 2]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kGBR:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 2], data[d + 0], data[d + 1]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kBRG:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 1], data[d + 2], data[d + 0]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                case pixel::LedMap::kBGR:
-                    for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                        auto const kPixelIndexStart = (j * kGroupingCount);
-                        for (uint32_t k = 0; k < kGroupingCount; k++) {
-                            output_type_.SetPixel(kPixelIndexStart + k, data[d + 2], data[d + 1], data[d + 0]);
-                        }
-                        d = d + 3;
-                    }
-                    break;
-                default:
-                    assert(0);
-                    __builtin_unreachable();
-                    break;
-            }
-        } else {
-            assert(kChannelsPerPixel == 4);
-            for (auto j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                auto const kPixelIndexStart = (j * kGroupingCount);
-                for (uint32_t k = 0; k < kGroupingCount; k++) {
-                    output_type_.SetPixel(kPixelIndexStart + k, data[d], data[d + 1], data[d + 2], data[d + 3]);
-                }
-                d = d + 4;
-            }
+        if ((kernel_type_ != PixelDmxConfiguration::GetType()) || (kernel_map_ != PixelDmxConfiguration::GetMap())) {
+            SelectKernel();
         }
 
+        kernel_(output_type_, data, d, length, kBeginIndex, kEndIndex, kGroupingCount);
+
 #if !defined(DMXNODE_PORTS)
         if (do_update) {
             if (__builtin_expect((blackout_), 0)) {
@@ -245,12 +189,18 @@ class PixelDmx final : public PixelDmxConfiguration {
 #error
 #endif
         if constexpr (do_update) {
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+            if (governor_.Receive(port_index, timing::Micros())) {
+                OutputFrame();
+            }
+#else
             if (port_index == port_info.protocol_port_index_last) {
                 if (__builtin_expect((blackout_), 0)) {
                     return;
                 }
                 output_type_.Update();
             }
+#endif
         }
 #endif
     }
@@ -259,6 +209,19 @@ class PixelDmx final : public PixelDmxConfiguration {
 
     void Sync() { output_type_.Update(); }
 
+    /**
+     * Starts the update that was requested while the output was busy,
+     * and with the governor the frame that was held back or is past its deadline.
+     */
+    void Run() {
+        output_type_.Run();
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+        if (governor_.Poll(timing::Micros())) {
+            OutputFrame();
+        }
+#endif
+    }
+
 #if defined(OUTPUT_HAVE_STYLESWITCH)
     void SetOutputStyle([[maybe_unused]] uint32_t port_index, [[maybe_unused]] dmxnode::OutputStyle output_style) {}
     dmxnode::OutputStyle GetOutputStyle([[maybe_unused]] uint32_t port_index) const { return dmxnode::OutputStyle::kDelta; }
@@ -267,10 +230,6 @@ class PixelDmx final : public PixelDmxConfiguration {
     void Blackout(bool blackout = true) {
         blackout_ = blackout;
 
-        while (output_type_.IsUpdating()) {
-            // wait for completion
-        }
-
         if (blackout) {
             output_type_.Blackout();
         } else {
@@ -278,13 +237,7 @@ class PixelDmx final : public PixelDmxConfiguration {
         }
     }
 
-    void FullOn() {
-        while (output_type_.IsUpdating()) {
-            // wait for completion
-        }
-
-        output_type_.FullOn();
-    }
+    void FullOn() { output_type_.FullOn(); }
 
     void Print() OVERRIDE { PixelDmxConfiguration::Get().Print(); }
 
@@ -351,7 +304,93 @@ class PixelDmx final : public PixelDmxConfiguration {
     }
 
    private:
+    using Kernel = void (*)(PixelOutputType&, const uint8_t*, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+
+    /**
+     * The pixel loop of a LED family and colour order, without configuration branches.
+     */
+    template <pixel::LedFamily kFamily, uint32_t kMap>
+    static void WritePixels(PixelOutputType& output_type, const uint8_t* data, uint32_t d, uint32_t length, uint32_t begin_index, uint32_t end_index, uint32_t grouping_count) {
+        constexpr uint32_t kChannelsPerPixel = (kFamily == pixel::LedFamily::kRtzRgbw) ? 4 : 3;
+
+        if ((begin_index >= end_index) || (d >= length)) {
+            return;
+        }
+
+        if (grouping_count == 1) {
+            const auto kCount = std::min(end_index - begin_index, (length - d + kChannelsPerPixel - 1) / kChannelsPerPixel);
+            output_type.template SetPixels<kFamily, kMap>(begin_index, &data[d], kCount);
+            return;
+        }
+
+        // A group is encoded once, the other pixels are copies
+        for (auto j = begin_index; (j < end_index) && (d < length); j++) {
+            auto const kPixelIndexStart = (j * grouping_count);
+            output_type.template SetPixels<kFamily, kMap>(kPixelIndexStart, &data[d], 1);
+            output_type.template RepeatPixel<kFamily>(kPixelIndexStart, grouping_count);
+            d = d + kChannelsPerPixel;
+        }
+    }
+
+    template <pixel::LedFamily kFamily> static Kernel GetKernel(pixel::LedMap map) {
+        static constexpr Kernel kKernels[] = {WritePixels<kFamily, 0>, WritePixels<kFamily, 1>, WritePixels<kFamily, 2>,
+                                              WritePixels<kFamily, 3>, WritePixels<kFamily, 4>, WritePixels<kFamily, 5>};
+        static_assert(sizeof(kKernels) / sizeof(kKernels[0]) == sizeof(pixel::kMapChannels) / sizeof(pixel::kMapChannels[0]));
+
+        const auto kMapIndex = static_cast<uint32_t>(map);
+        return kKernels[kMapIndex < (sizeof(kKernels) / sizeof(kKernels[0])) ? kMapIndex : 0];
+    }
+
+    /**
+     * The configuration can also be changed with RDM, after which only the output is applied
+     */
+    void SelectKernel() {
+        kernel_type_ = PixelDmxConfiguration::GetType();
+        kernel_map_ = PixelDmxConfiguration::GetMap();
+
+        switch (pixel::GetFamily(kernel_type_)) {
+            case pixel::LedFamily::kRtz:
+                kernel_ = GetKernel<pixel::LedFamily::kRtz>(kernel_map_);
+                break;
+            case pixel::LedFamily::kRtzRgbw:
+                kernel_ = WritePixels<pixel::LedFamily::kRtzRgbw, 0>;
+                break;
+            case pixel::LedFamily::kWS2801:
+                kernel_ = GetKernel<pixel::LedFamily::kWS2801>(kernel_map_);
+                break;
+            case pixel::LedFamily::kAPA102:
+                kernel_ = GetKernel<pixel::LedFamily::kAPA102>(kernel_map_);
+                break;
+            case pixel::LedFamily::kP9813:
+                kernel_ = GetKernel<pixel::LedFamily::kP9813>(kernel_map_);
+                break;
+            default:
+                assert(0);
+                __builtin_unreachable();
+                break;
+        }
+    }
+
+   private:
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    void OutputFrame() {
+        governor_.Output();
+
+        if (__builtin_expect((blackout_), 0)) {
+            return;
+        }
+
+        output_type_.Update();
+    }
+#endif
+
     PixelOutputType output_type_;
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    pixel::Governor governor_;
+#endif
+    Kernel kernel_{nullptr};
+    pixel::LedType kernel_type_{pixel::LedType::kUndefined};
+    pixel::LedMap kernel_map_{pixel::LedMap::kUndefined};
 
     bool started_{false};
     bool blackout_{false};
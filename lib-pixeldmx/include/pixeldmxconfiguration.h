@@ -72,6 +72,10 @@ class PixelDmxConfiguration : public PixelConfiguration {
 
     uint32_t GetGroups() const { return groups_; }
 
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    uint32_t GetPortGroups(uint32_t port_index) const { return PixelConfiguration::GetPortCount(port_index) / grouping_count_; }
+#endif
+
     uint32_t GetUniverses() const { return universes_; }
 
     pixeldmxconfiguration::PortInfo& GetPortInfo() { return port_info_; }
@@ -87,9 +91,47 @@ class PixelDmxConfiguration : public PixelConfiguration {
 
     uint16_t GetDmxFootprint() const { return dmx_footprint_; }
 
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    /**
+     * RTZ multi output only: a colour is 2 slots, coarse and fine.
+     */
+    void SetInput16Bit(bool input_16bit) { input_16bit_ = input_16bit; }
+    bool IsInput16Bit() const { return input_16bit_; }
+#endif
+
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    /**
+     * The time after the first universe of a frame in which the others must arrive, 0 is the default.
+     */
+    void SetFrameDeadlineMillis(uint8_t frame_deadline_millis) { frame_deadline_millis_ = frame_deadline_millis; }
+    uint32_t GetFrameDeadlineMillis() const { return frame_deadline_millis_; }
+#endif
+
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    /**
+     * The output ports that are interpolated, bit 0 is the first port.
+     */
+    void SetInterpolationPorts(uint32_t port_mask) { interpolation_ports_ = port_mask; }
+    bool IsPortInterpolation(uint32_t out_index) const { return (interpolation_ports_ & (1U << out_index)) != 0; }
+#endif
+
+    uint32_t GetChannelsPerPixel() const {
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        if (input_16bit_) {
+            return 2U * PixelConfiguration::GetLedsPerPixel();
+        }
+#endif
+        return PixelConfiguration::GetLedsPerPixel();
+    }
+
     void Validate(uint32_t ports_max) {
         DEBUG_ENTRY();
 
+        output_ports_ = std::min(ports_max, output_ports_);
+
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+        PixelConfiguration::SetActivePorts(output_ports_);
+#endif
         PixelConfiguration::Validate();
 
         if (!PixelConfiguration::IsRTZProtocol()) {
@@ -100,16 +142,20 @@ class PixelDmxConfiguration : public PixelConfiguration {
             PixelConfiguration::Validate();
         }
 
-        port_info_.begin_index_port[0] = 0;
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+#if defined(NODE_DDP_DISPLAY)
+        input_16bit_ = false; // The DDP offsets are in 8-bit colours
+#endif
+        if ((ports_max == 1) || !PixelConfiguration::IsRTZProtocol()) {
+            input_16bit_ = false;
+        }
+#endif
 
-        if (PixelConfiguration::GetType() == pixel::LedType::kSK6812W) {
-            port_info_.begin_index_port[1] = 128;
-            port_info_.begin_index_port[2] = 256;
-            port_info_.begin_index_port[3] = 384;
-        } else {
-            port_info_.begin_index_port[1] = 170;
-            port_info_.begin_index_port[2] = 340;
-            port_info_.begin_index_port[3] = 510;
+        // 170 RGB or 128 RGBW pixels in a universe, half of it with 16-bit input
+        const auto kPixelsPerUniverse = static_cast<uint16_t>(dmxnode::kUniverseSize / GetChannelsPerPixel());
+
+        for (uint32_t i = 0; i < 4; i++) {
+            port_info_.begin_index_port[i] = static_cast<uint16_t>(i * kPixelsPerUniverse);
         }
 
         if ((grouping_count_ == 0) || (grouping_count_ > PixelConfiguration::GetCount())) {
@@ -117,9 +163,18 @@ class PixelDmxConfiguration : public PixelConfiguration {
         }
 
         groups_ = PixelConfiguration::GetCount() / grouping_count_;
-        output_ports_ = std::min(ports_max, output_ports_);
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        // A port has at most 4 universes, with 16-bit input that limits the count
+        if (groups_ > (4U * kPixelsPerUniverse)) {
+            groups_ = 4U * kPixelsPerUniverse;
+            PixelConfiguration::SetCount(groups_ * grouping_count_);
+            PixelConfiguration::Validate();
+        }
+#endif
+
         universes_ = (1U + (groups_ / (1U + port_info_.begin_index_port[1])));
-        dmx_footprint_ = static_cast<uint16_t>(PixelConfiguration::GetLedsPerPixel() * groups_);
+        dmx_footprint_ = static_cast<uint16_t>(GetChannelsPerPixel() * groups_);
         
 		if (dmx_start_address_ == 0) {
             dmx_start_address_ = dmxnode::kStartAddressDefault;
@@ -169,6 +224,15 @@ class PixelDmxConfiguration : public PixelConfiguration {
     uint32_t universes_{0};
     uint16_t dmx_start_address_{1};
     uint16_t dmx_footprint_{0};
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    bool input_16bit_{false};
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    uint8_t frame_deadline_millis_{0};
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    uint32_t interpolation_ports_{0};
+#endif
     pixeldmxconfiguration::PortInfo port_info_;
 
     static inline PixelDmxConfiguration* s_this;
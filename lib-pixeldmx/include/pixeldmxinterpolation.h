@@ -0,0 +1,214 @@
+/**
+ * @file pixeldmxinterpolation.h
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef PIXELDMXINTERPOLATION_H_
+#define PIXELDMXINTERPOLATION_H_
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+
+#include "dmxnode.h"
+
+namespace pixeldmx {
+/**
+ * Blends from what is shown to the newest frame over the measured packet interval,
+ * so that the output can refresh faster than the source sends.
+ *
+ * The blend is done on the DMX values, before the gamma table, which makes the
+ * steps even in perceived brightness. The intermediate is 8.8 fixed point, with
+ * dithering it is given as is by Get16.
+ *
+ * Interpolation is off by default. The frame buffers of a port are allocated the
+ * first time it is enabled, and kept for when it is enabled again.
+ */
+template <uint32_t kPorts> class Interpolation {
+    static constexpr uint32_t kMinPeriodMicros = 4000;  ///< 250 Hz
+    static constexpr uint32_t kMaxPeriodMicros = 100000; ///< Slower sources, or a pause, are not interpolated
+
+   public:
+    Interpolation() = default;
+
+    void SetEnabled(uint32_t port_index, bool enable) {
+        assert(port_index < kPorts);
+        auto& port = port_[port_index];
+
+        port.length = 0;
+        port.is_blending = false;
+        port.is_enabled = false;
+
+        if (!enable) {
+            return;
+        }
+
+        if (blended_ == nullptr) {
+            blended_ = new uint8_t[dmxnode::kUniverseSize];
+        }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        if (blended16_ == nullptr) {
+            blended16_ = new uint8_t[dmxnode::kUniverseSize * 2];
+        }
+
+        if (blended16_ == nullptr) {
+            return;
+        }
+#endif
+
+        if (port.frames == nullptr) {
+            port.frames = new Frames;
+        }
+
+        port.is_enabled = (blended_ != nullptr) && (port.frames != nullptr);
+    }
+
+    bool IsEnabled(uint32_t port_index) const {
+        assert(port_index < kPorts);
+        return port_[port_index].is_enabled;
+    }
+
+    /**
+     * A new frame has arrived: the blend restarts from the output shown now.
+     */
+    void SetTarget(uint32_t port_index, const uint8_t* data, uint32_t length, uint32_t micros) {
+        assert(port_index < kPorts);
+        assert(data != nullptr);
+        assert(length <= dmxnode::kUniverseSize);
+
+        auto& port = port_[port_index];
+        const auto kPeriod = micros - port.arrival_micros;
+
+        if (port.is_blending) {
+            Blend(port, micros, [from = port.frames->from](uint32_t i, int32_t value) { from[i] = static_cast<uint8_t>((value + 0x80) >> 8); });
+        } else {
+            memcpy(port.frames->from, port.frames->to, port.length);
+        }
+
+        if (length > port.length) {
+            memcpy(&port.frames->from[port.length], &data[port.length], length - port.length);
+        }
+
+        memcpy(port.frames->to, data, length);
+
+        port.length = length;
+        port.arrival_micros = micros;
+        port.period_micros = (kPeriod > kMaxPeriodMicros) ? 0 : std::max(kPeriod, kMinPeriodMicros);
+        port.is_blending = (port.period_micros != 0);
+
+        if (!port.is_blending) {
+            memcpy(port.frames->from, data, length);
+        }
+    }
+
+    /**
+     * @return The blended frame, valid until the next call
+     */
+    const uint8_t* Get(uint32_t port_index, uint32_t micros) {
+        assert(port_index < kPorts);
+        auto& port = port_[port_index];
+
+        if (!port.is_blending) {
+            return port.frames->to;
+        }
+
+        if ((micros - port.arrival_micros) >= port.period_micros) {
+            port.is_blending = false;
+            return port.frames->to;
+        }
+
+        Blend(port, micros, [blended = blended_](uint32_t i, int32_t value) { blended[i] = static_cast<uint8_t>((value + 0x80) >> 8); });
+        return blended_;
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    /**
+     * The blend in 8.8 fixed point, 2 bytes per slot with the integer part first.
+     * @return nullptr when there is nothing to blend, Get then gives the frame
+     */
+    const uint8_t* Get16(uint32_t port_index, uint32_t micros) {
+        assert(port_index < kPorts);
+        const auto& port = port_[port_index];
+
+        if (!port.is_blending || ((micros - port.arrival_micros) >= port.period_micros)) {
+            return nullptr;
+        }
+
+        Blend(port, micros, [blended = blended16_](uint32_t i, int32_t value) {
+            blended[i * 2] = static_cast<uint8_t>(value >> 8);
+            blended[i * 2 + 1] = static_cast<uint8_t>(value);
+        });
+        return blended16_;
+    }
+#endif
+
+    uint32_t GetLength(uint32_t port_index) const {
+        assert(port_index < kPorts);
+        return port_[port_index].length;
+    }
+
+    bool IsBlending(uint32_t port_index) const {
+        assert(port_index < kPorts);
+        return port_[port_index].is_blending;
+    }
+
+   private:
+    struct Frames {
+        uint8_t from[dmxnode::kUniverseSize];
+        uint8_t to[dmxnode::kUniverseSize];
+    };
+
+    struct Port {
+        Frames* frames{nullptr};
+        uint32_t length{0};
+        uint32_t arrival_micros{0};
+        uint32_t period_micros{0}; ///< 0 is no blending
+        bool is_blending{false};
+        bool is_enabled{false};
+    };
+
+    /**
+     * Stores the 8.8 blend of each slot
+     */
+    template <typename Store> static void Blend(const Port& port, uint32_t micros, Store store) {
+        const auto kElapsed = std::min(micros - port.arrival_micros, port.period_micros);
+        // 0..256, kElapsed * 256 fits as the period is at most kMaxPeriodMicros
+        const auto kFraction = static_cast<int32_t>((kElapsed << 8) / port.period_micros);
+
+        for (uint32_t i = 0; i < port.length; i++) {
+            const auto kFrom = static_cast<int32_t>(port.frames->from[i]);
+            const auto kValue = (kFrom << 8) + ((static_cast<int32_t>(port.frames->to[i]) - kFrom) * kFraction);
+            store(i, kValue);
+        }
+    }
+
+    Port port_[kPorts];
+    uint8_t* blended_{nullptr};
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    uint8_t* blended16_{nullptr};
+#endif
+};
+} // namespace pixeldmx
+
+#endif // PIXELDMXINTERPOLATION_H_
@@ -44,6 +44,15 @@
 #include "pixeloutputmulti.h"
 #include "pixeldmxconfiguration.h"
 #include "logic_analyzer.h"
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+#include "pixeldmxinterpolation.h"
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+#include "pixelgovernor.h"
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION) || defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+#include "timing.h"
+#endif
 #if defined(PIXELDMXSTARTSTOP_GPIO)
 #include "gpio.h"
 #endif
@@ -90,8 +99,19 @@ class PixelDmxMulti final : public PixelDmxConfiguration {
         PixelDmxConfiguration::Print();
 #endif
 
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        output_type_.SetInput16Bit(PixelDmxConfiguration::IsInput16Bit());
+#endif
         output_type_.ApplyConfiguration();
         output_type_.Blackout();
+
+        SelectKernels();
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+        SetupGovernor();
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+        SetupInterpolation();
+#endif
     }
 
     void Start(uint32_t port_index) {
@@ -136,29 +156,96 @@ class PixelDmxMulti final : public PixelDmxConfiguration {
     void SetData(uint32_t port_index, const uint8_t* data, uint32_t length) {
         logic_analyzer::Ch0Set();
 
-        SetData(port_index, data, length);
-
-        auto& port_info = PixelDmxConfiguration::GetPortInfo();
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+        if (interpolation_.IsEnabled(port_index)) {
+            const auto kMicros = timing::Micros();
+            interpolation_.SetTarget(port_index, data, length, kMicros);
+            SetInterpolatedData(port_index, kMicros);
+        } else
+#endif
+        {
+            SetData(port_index, data, length);
+        }
 
         if constexpr (doUpdate) {
-            if (port_index == port_info.protocol_port_index_last) {
-                logic_analyzer::Ch1Set();
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+            if (governor_.Receive(port_index, timing::Micros())) {
+                OutputFrame();
+                governor_.Output();
+            }
+#else
+            if (port_index == PixelDmxConfiguration::GetPortInfo().protocol_port_index_last) {
+                OutputFrame();
+            }
+#endif
+        }
 
-                for (uint32_t index = 0; index <= port_info.protocol_port_index_last; index++) {
-                    logic_analyzer::Ch2Set();
-                    SetData(index, dmxnode::Data::Backup(index), dmxnode::Data::GetLength(index));
-                    logic_analyzer::Ch2Clear();
-                }
+        logic_analyzer::Ch0Clear();
+    }
 
-                output_type_.Update();
+    /**
+     * Starts the update that was requested while the output was busy.
+     * With the governor, outputs the frame that was held back by the rate limit or
+     * is past its deadline. With interpolation, outputs the intermediate frames,
+     * as often as the output allows.
+     */
+    void Run() {
+        output_type_.Run();
+
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+        if (governor_.Poll(timing::Micros())) {
+            OutputFrame();
+            governor_.Output();
+            return;
+        }
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+        if (output_type_.IsUpdating() || blackout_) {
+            return;
+        }
 
-                logic_analyzer::Ch1Clear();
+        auto& port_info = PixelDmxConfiguration::GetPortInfo();
+        const auto kMicros = timing::Micros();
+        auto is_blending = false;
+
+        for (uint32_t index = 0; index <= port_info.protocol_port_index_last; index++) {
+            if (interpolation_.IsEnabled(index) && interpolation_.IsBlending(index)) {
+                SetInterpolatedData(index, kMicros);
+                is_blending = true;
             }
         }
 
+        if (is_blending) {
+            output_type_.Update();
+        }
+#endif
+    }
+
+
+#if defined(NODE_DDP_DISPLAY)
+    /**
+     * DDP: writes the channels of an output port from a byte offset in the port,
+     * straight into the output buffer. The offset is at the start of a pixel.
+     */
+    void SetPixelData(uint32_t out_index, uint32_t byte_offset, const uint8_t* data, uint32_t length) {
+        logic_analyzer::Ch0Set();
+        WriteGroups(out_index, byte_offset / PixelDmxConfiguration::GetChannelsPerPixel(), data, length);
         logic_analyzer::Ch0Clear();
     }
 
+    /**
+     * DDP: outputs the pixel data written, at the PUSH
+     */
+    void OutputPixelData() {
+        if (!blackout_) {
+            output_type_.Update();
+        }
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+        governor_.Output(); // The frames per second
+#endif
+    }
+#endif
+
     void Sync([[maybe_unused]] uint32_t port_index) {
         logic_analyzer::Ch2Set();
 
@@ -189,10 +276,6 @@ class PixelDmxMulti final : public PixelDmxConfiguration {
     void Blackout(bool blackout = true) {
         blackout_ = blackout;
 
-        while (output_type_.IsUpdating()) {
-            // wait for completion
-        }
-
         if (blackout) {
             output_type_.Blackout();
         } else {
@@ -200,13 +283,7 @@ class PixelDmxMulti final : public PixelDmxConfiguration {
         }
     }
 
-    void FullOn() {
-        while (output_type_.IsUpdating()) {
-            // wait for completion
-        }
-
-        output_type_.FullOn();
-    }
+    void FullOn() { output_type_.FullOn(); }
 
     void Print() { PixelDmxConfiguration::Get().Print(); }
 
@@ -233,7 +310,113 @@ class PixelDmxMulti final : public PixelDmxConfiguration {
     }
 
    private:
-    void SetData(uint32_t port_index, const uint8_t* data, uint32_t length) {
+    /**
+     * Writes all universes of the frame again, the newest data of each, and outputs it.
+     */
+    void OutputFrame() {
+        logic_analyzer::Ch1Set();
+
+        auto& port_info = PixelDmxConfiguration::GetPortInfo();
+
+        for (uint32_t index = 0; index <= port_info.protocol_port_index_last; index++) {
+            logic_analyzer::Ch2Set();
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+            if (interpolation_.IsEnabled(index)) {
+                SetInterpolatedData(index, timing::Micros());
+                logic_analyzer::Ch2Clear();
+                continue;
+            }
+#endif
+            SetData(index, dmxnode::Data::Acquire(index), dmxnode::Data::GetLength(index));
+            logic_analyzer::Ch2Clear();
+        }
+
+        output_type_.Update();
+
+        logic_analyzer::Ch1Clear();
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    /**
+     * A frame is the universes in use on each output port, a port with
+     * a smaller count can have fewer universes. A mirror port has none.
+     */
+    void SetupGovernor() {
+        const auto kPixelsPerUniverse = 1U + PixelDmxConfiguration::GetPortInfo().begin_index_port[1];
+        const auto kOutputPorts = PixelDmxConfiguration::GetOutputPorts();
+
+        governor_.Reset();
+
+        for (uint32_t out_index = 0; out_index < kOutputPorts; out_index++) {
+            if (PixelDmxConfiguration::IsPortMirror(out_index)) {
+                continue;
+            }
+
+            const auto kUniverses = 1U + (PixelDmxConfiguration::GetPortGroups(out_index) / kPixelsPerUniverse);
+#if defined(NODE_DDP_DISPLAY)
+            const auto kFirst = out_index * 4U;
+#else
+            const auto kFirst = out_index * PixelDmxConfiguration::GetUniverses();
+#endif
+            for (uint32_t universe = 0; universe < kUniverses; universe++) {
+                governor_.SetExpected(kFirst + universe);
+            }
+        }
+
+        governor_.SetDeadlineMillis(PixelDmxConfiguration::GetFrameDeadlineMillis());
+        governor_.SetRefreshRate(PixelConfiguration::GetRefreshRate());
+    }
+#endif
+
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    /**
+     * The universes of an interpolated output port are enabled, the others disabled.
+     */
+    void SetupInterpolation() {
+        const auto kOutputPorts = PixelDmxConfiguration::GetOutputPorts();
+#if defined(NODE_DDP_DISPLAY)
+        static constexpr uint32_t kUniverses = 4;
+#else
+        const auto kUniverses = PixelDmxConfiguration::GetUniverses();
+#endif
+
+        for (uint32_t port_index = 0; port_index < dmxnode::kMaxPorts; port_index++) {
+            const auto kOutIndex = port_index / kUniverses;
+            auto enable = (kOutIndex < kOutputPorts) && PixelDmxConfiguration::IsPortInterpolation(kOutIndex) && !PixelDmxConfiguration::IsPortMirror(kOutIndex);
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+            // The bytes are blended one by one, a 16-bit colour would step at the carry of the fine byte
+            enable = enable && !PixelDmxConfiguration::IsInput16Bit();
+#endif
+
+            if (enable != interpolation_.IsEnabled(port_index)) {
+                interpolation_.SetEnabled(port_index, enable);
+            }
+        }
+    }
+
+    /**
+     * With dithering an RTZ port gets the blend in 16 bits, else it is rounded to 8 bits.
+     */
+    void SetInterpolatedData(uint32_t port_index, uint32_t micros) {
+        const auto kLength = interpolation_.GetLength(port_index);
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        if (IsFamilyRtz(PixelDmxConfiguration::GetType())) {
+            const auto* const kBlend = interpolation_.Get16(port_index, micros);
+
+            if (kBlend != nullptr) {
+                SetData(port_index, kBlend, kLength, true);
+                return;
+            }
+        }
+#endif
+        SetData(port_index, interpolation_.Get(port_index, micros), kLength);
+    }
+#endif
+
+    /**
+     * is_blend: the data is the 8.8 blend of the interpolation, 2 bytes per slot
+     */
+    void SetData(uint32_t port_index, const uint8_t* data, uint32_t length, [[maybe_unused]] bool is_blend = false) {
         assert(data != nullptr);
         assert(length <= dmxnode::kUniverseSize);
 
@@ -245,103 +428,182 @@ class PixelDmxMulti final : public PixelDmxConfiguration {
         const auto kOutIndex = (port_index / kUniverses);
         const auto kSwitch = port_index - (kOutIndex * kUniverses);
 #endif
-        auto& port_info = PixelDmxConfiguration::GetPortInfo();
+        WriteGroups(kOutIndex, PixelDmxConfiguration::GetPortInfo().begin_index_port[kSwitch], data, length, is_blend);
+    }
+
+    /**
+     * Writes the groups of an output port from begin_index, for each group the channels of a pixel.
+     */
+    void WriteGroups(uint32_t out_index, uint32_t begin_index, const uint8_t* data, uint32_t length, [[maybe_unused]] bool is_blend = false) {
+        // The output copies the source port
+        if (PixelDmxConfiguration::IsPortMirror(out_index)) {
+            return;
+        }
 
-        const auto kGroups = PixelDmxConfiguration::GetGroups();
-        const auto kBeginIndex = port_info.begin_index_port[kSwitch];
-        const auto kChannelsPerPixel = PixelDmxConfiguration::GetLedsPerPixel();
-        const auto kEndIndex = std::min(kGroups, (kBeginIndex + (length / kChannelsPerPixel)));
+        const auto kGroups = PixelDmxConfiguration::GetPortGroups(out_index);
+        const auto kChannelsPerPixel = PixelDmxConfiguration::GetChannelsPerPixel();
+        const auto kEndIndex = std::min(kGroups, (begin_index + (length / kChannelsPerPixel)));
         const auto kGroupingCount = PixelDmxConfiguration::GetGroupingCount();
-        const auto kPixelType = PixelDmxConfiguration::GetType();
-        const auto kIsRtzProtocol = PixelDmxConfiguration::IsRTZProtocol();
+
+        if ((kernel_type_ != PixelDmxConfiguration::GetType()) || (kernel_map_ != PixelDmxConfiguration::GetMap())
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+            || (kernel_input_16bit_ != PixelDmxConfiguration::IsInput16Bit())
+#endif
+        ) {
+            SelectKernels();
+        }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER) && defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+        if (is_blend) {
+            kernel_blend_[out_index](output_type_, out_index, data, length * 2, begin_index, kEndIndex, kGroupingCount);
+            return;
+        }
+#endif
+        kernel_[out_index](output_type_, out_index, data, length, begin_index, kEndIndex, kGroupingCount);
+    }
+
+    using Kernel = void (*)(PixelOutputType&, uint32_t, const uint8_t*, uint32_t, uint32_t, uint32_t, uint32_t);
+
+    /**
+     * The pixel loop of a LED family and colour order, without configuration branches.
+     */
+    template <pixel::LedFamily kFamily, uint32_t kMap, bool kInput16Bit, bool kBlend>
+    static void SetPixels(PixelOutputType& output_type, uint32_t out_index, uint32_t first_pixel, const uint8_t* data, uint32_t count) {
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        if constexpr (kBlend) {
+            output_type.template SetPixelsBlend<kFamily, kMap>(out_index, first_pixel, data, count);
+            return;
+        }
+
+        if constexpr (kInput16Bit) {
+            output_type.template SetPixels16<kFamily, kMap>(out_index, first_pixel, data, count);
+            return;
+        }
+#endif
+        output_type.template SetPixels<kFamily, kMap>(out_index, first_pixel, data, count);
+    }
+
+    template <pixel::LedFamily kFamily, uint32_t kMap, bool kInput16Bit = false, bool kBlend = false>
+    static void WritePixels(PixelOutputType& output_type, uint32_t out_index, const uint8_t* data, uint32_t length, uint32_t begin_index, uint32_t end_index, uint32_t grouping_count) {
+        constexpr uint32_t kChannelsPerPixel = ((kFamily == pixel::LedFamily::kRtzRgbw) ? 4 : 3) * ((kInput16Bit || kBlend) ? 2 : 1);
+
+        if (begin_index >= end_index) {
+            return;
+        }
+
+        if (grouping_count == 1) {
+            SetPixels<kFamily, kMap, kInput16Bit, kBlend>(output_type, out_index, begin_index, data, end_index - begin_index);
+            return;
+        }
 
         uint32_t d = 0;
 
-        if (kChannelsPerPixel == 3) {
-            // Define a lambda to handle pixel setting based on color order
-            auto set_pixels_colour_rtz = [&](uint32_t portindex, uint32_t pixelindex, uint8_t r, uint8_t g, uint8_t b) {
-#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
-                const auto kGammaTable = PixelDmxConfiguration::GetGammaTable();
-                r = kGammaTable[r];
-                g = kGammaTable[g];
-                b = kGammaTable[b];
-#endif
-                output_type_.SetColourRTZ(portindex, pixelindex, r, g, b);
-            };
-
-            // Define a lambda to handle pixel setting based on color order
-            auto set_pixels_colour3 = [&](uint32_t portindex, uint32_t pixelindex, uint8_t r, uint8_t g, uint8_t b) {
-#if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
-                const auto kGammaTable = PixelDmxConfiguration::GetGammaTable();
-                r = kGammaTable[r];
-                g = kGammaTable[g];
-                b = kGammaTable[b];
-#endif
-
-                switch (kPixelType) {
-                    case pixel::LedType::kWS2801:
-                        output_type_.SetColourWS2801(portindex, pixelindex, r, g, b);
-                        break;
-                    case pixel::LedType::kAPA102:
-                    case pixel::LedType::kSK9822:
-                        output_type_.SetPixel4Bytes(portindex, 1 + pixelindex, PixelDmxConfiguration::GetGlobalBrightness(), b, g, r);
-                        break;
-                    case pixel::LedType::kP9813: {
-                        const auto kFlag = static_cast<uint8_t>(0xC0 | ((~b & 0xC0) >> 2) | ((~r & 0xC0) >> 4) | ((~r & 0xC0) >> 6));
-                        output_type_.SetPixel4Bytes(portindex, 1 + pixelindex, kFlag, b, g, r);
-                    } break;
-                    default:
-                        assert(0);
-                        __builtin_unreachable();
-                        break;
-                }
-            };
-
-            constexpr uint32_t kChannelMap[6][3] = {
-                {0, 1, 2}, // RGB
-                {0, 2, 1}, // RBG
-                {1, 0, 2}, // GRB
-                {2, 0, 1}, // GBR
-                {1, 2, 0}, // BRG
-                {2, 1, 0}  // BGR
-            };
-
-            const auto kMapIndex = static_cast<uint32_t>(PixelDmxConfiguration::GetMap());
-            // Ensure mapIndex is within valid bounds
-            assert(kMapIndex < sizeof(kChannelMap) / sizeof(kChannelMap[0])); // Runtime check
-            auto const& map = kChannelMap[kMapIndex];
-
-            if (kIsRtzProtocol) {
-                for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                    auto const kPixelIndexStart = j * kGroupingCount;
-                    for (uint32_t k = 0; k < kGroupingCount; k++) {
-                        set_pixels_colour_rtz(kOutIndex, kPixelIndexStart + k, data[d + map[0]], data[d + map[1]], data[d + map[2]]);
-                    }
-                    d += 3; // Increment by 3 since we're processing 3 channels per pixel
-                }
-            } else {
-                for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                    auto const kPixelIndexStart = j * kGroupingCount;
-                    for (uint32_t k = 0; k < kGroupingCount; k++) {
-                        set_pixels_colour3(kOutIndex, kPixelIndexStart + k, data[d + map[0]], data[d + map[1]], data[d + map[2]]);
-                    }
-                    d += 3; // Increment by 3 since we're processing 3 channels per pixel
-                }
-            }
-        } else {
-            assert(kChannelsPerPixel == 4);
-            assert(kIsRtzProtocol);
-            for (uint32_t j = kBeginIndex; (j < kEndIndex) && (d < length); j++) {
-                auto const kPixelIndexStart = (j * kGroupingCount);
-                for (uint32_t k = 0; k < kGroupingCount; k++) {
-                    output_type_.SetColourRTZ(kOutIndex, kPixelIndexStart + k, data[d], data[d + 1], data[d + 2], data[d + 3]);
-                }
-                d = d + 4; // Increment by 4 since we're processing 4 channels per pixel
+        // A group is encoded once, the other pixels are copies
+        for (uint32_t j = begin_index; (j < end_index) && (d < length); j++) {
+            auto const kPixelIndexStart = j * grouping_count;
+            SetPixels<kFamily, kMap, kInput16Bit, kBlend>(output_type, out_index, kPixelIndexStart, &data[d], 1);
+            output_type.template RepeatPixel<kFamily>(out_index, kPixelIndexStart, grouping_count);
+            d += kChannelsPerPixel;
+        }
+    }
+
+    template <pixel::LedFamily kFamily, bool kInput16Bit = false, bool kBlend = false> static Kernel GetKernel(pixel::LedMap map) {
+        static constexpr Kernel kKernels[] = {WritePixels<kFamily, 0, kInput16Bit, kBlend>, WritePixels<kFamily, 1, kInput16Bit, kBlend>, WritePixels<kFamily, 2, kInput16Bit, kBlend>,
+                                              WritePixels<kFamily, 3, kInput16Bit, kBlend>, WritePixels<kFamily, 4, kInput16Bit, kBlend>, WritePixels<kFamily, 5, kInput16Bit, kBlend>};
+        static_assert(sizeof(kKernels) / sizeof(kKernels[0]) == sizeof(pixel::kMapChannels) / sizeof(pixel::kMapChannels[0]));
+
+        const auto kMapIndex = static_cast<uint32_t>(map);
+        return kKernels[kMapIndex < (sizeof(kKernels) / sizeof(kKernels[0])) ? kMapIndex : 0];
+    }
+
+    /**
+     * The configuration can also be changed with RDM, after which only the output is applied.
+     * The ports share the family, a port can have its own map.
+     */
+    void SelectKernels() {
+        kernel_type_ = PixelDmxConfiguration::GetType();
+        kernel_map_ = PixelDmxConfiguration::GetMap();
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        kernel_input_16bit_ = PixelDmxConfiguration::IsInput16Bit();
+#endif
+
+        for (uint32_t port_index = 0; port_index < pixeldmxmulti::kMaxPorts; port_index++) {
+            kernel_[port_index] = SelectKernel(PixelDmxConfiguration::GetPortMap(port_index));
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER) && defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+            kernel_blend_[port_index] = SelectKernelBlend(PixelDmxConfiguration::GetPortMap(port_index));
+#endif
+        }
+    }
+
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER) && defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    static bool IsFamilyRtz(pixel::LedType type) {
+        const auto kFamily = pixel::GetFamily(type);
+        return (kFamily == pixel::LedFamily::kRtz) || (kFamily == pixel::LedFamily::kRtzRgbw);
+    }
+
+    /**
+     * The interpolated frame of an RTZ type, nullptr for the other types
+     */
+    Kernel SelectKernelBlend(pixel::LedMap map) const {
+        switch (pixel::GetFamily(kernel_type_)) {
+            case pixel::LedFamily::kRtz:
+                return GetKernel<pixel::LedFamily::kRtz, false, true>(map);
+            case pixel::LedFamily::kRtzRgbw:
+                return WritePixels<pixel::LedFamily::kRtzRgbw, 0, false, true>;
+            default:
+                return nullptr;
+        }
+    }
+#endif
+
+    Kernel SelectKernel(pixel::LedMap map) const {
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        // Validate allows the 16-bit input for the RTZ types only
+        if (kernel_input_16bit_) {
+            if (pixel::GetFamily(kernel_type_) == pixel::LedFamily::kRtzRgbw) {
+                return WritePixels<pixel::LedFamily::kRtzRgbw, 0, true>;
             }
+
+            return GetKernel<pixel::LedFamily::kRtz, true>(map);
+        }
+#endif
+
+        switch (pixel::GetFamily(kernel_type_)) {
+            case pixel::LedFamily::kRtz:
+                return GetKernel<pixel::LedFamily::kRtz>(map);
+            case pixel::LedFamily::kRtzRgbw:
+                return WritePixels<pixel::LedFamily::kRtzRgbw, 0>;
+            case pixel::LedFamily::kWS2801:
+                return GetKernel<pixel::LedFamily::kWS2801>(map);
+            case pixel::LedFamily::kAPA102:
+                return GetKernel<pixel::LedFamily::kAPA102>(map);
+            case pixel::LedFamily::kP9813:
+                return GetKernel<pixel::LedFamily::kP9813>(map);
+            default:
+                assert(0);
+                __builtin_unreachable();
+                break;
         }
     }
 
     PixelOutputType output_type_;
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    pixeldmx::Interpolation<dmxnode::kMaxPorts> interpolation_;
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    pixel::Governor governor_;
+#endif
+
+    Kernel kernel_[pixeldmxmulti::kMaxPorts];
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER) && defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    Kernel kernel_blend_[pixeldmxmulti::kMaxPorts];
+#endif
+    pixel::LedType kernel_type_{pixel::LedType::kUndefined};
+    pixel::LedMap kernel_map_{pixel::LedMap::kUndefined};
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    bool kernel_input_16bit_{false};
+#endif
 
     uint32_t started_[2]; ///< Support for 16x4 = 64 ports.
     bool blackout_{false};
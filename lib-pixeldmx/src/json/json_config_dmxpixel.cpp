@@ -24,6 +24,7 @@
  */
 
 #include <cstdint>
+#include <cstdio>
 #include <algorithm>
 #include <utility>
 
@@ -62,6 +63,12 @@ uint32_t GetPixelDmx(char* buffer, uint32_t length) {
         doc[DmxLedParamsConst::kGroupingCount.name] = pixel_dmx_configuration.GetGroupingCount();
 #if defined(OUTPUT_DMX_PIXEL_MULTI)
         doc[DmxLedParamsConst::kActiveOutputPorts.name] = pixel_dmx_configuration.GetOutputPorts();
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+        doc[PixelDmxParamsConst::kInput16Bit.name] = static_cast<uint32_t>(pixel_dmx_configuration.IsInput16Bit());
+#endif
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+        doc[PixelDmxParamsConst::kFrameDeadline.name] = pixel_dmx_configuration.GetFrameDeadlineMillis();
 #endif
 #if defined(RDM_RESPONDER)
         doc[PixelDmxParamsConst::kDmxStartAddress.name] = pixel_dmx_configuration.GetDmxStartAddress();
@@ -74,6 +81,36 @@ uint32_t GetPixelDmx(char* buffer, uint32_t length) {
             doc[PixelDmxParamsConst::kStartUniPort[i].name] = ConfigStore::Instance().DmxLedIndexedGetStartUniverse(i);
         }
 
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+        // As stored, 0 and "" are the count and the type, 0 is no mirror, "" is no matrix
+        common::store::DmxLedPorts ports;
+        ConfigStore::Instance().Copy(&ports, &ConfigurationStore::dmx_led_ports);
+        common::store::DmxLedMatrix matrix;
+        ConfigStore::Instance().Copy(&matrix, &ConfigurationStore::dmx_led_matrix);
+
+        for (uint32_t i = 0; i < kMaxStartUniverses; i++) {
+            const auto kType = ports.type[i];
+            doc[PixelDmxParamsConst::kCountPort[i].name] = ports.count[i];
+            doc[PixelDmxParamsConst::kTypePort[i].name] = (kType == 0) ? "" : pixel::GetTypeName(static_cast<pixel::LedType>(kType - 1U));
+            doc[PixelDmxParamsConst::kMirrorPort[i].name] = ports.mirror[i];
+
+            char coefficients[sizeof(matrix.coefficient[0]) * 5];
+            uint32_t k = 0;
+
+            if (pixel::ColourMatrix::IsSet(matrix.coefficient[i])) {
+                for (uint32_t j = 0; j < sizeof(matrix.coefficient[0]); j++) {
+                    k += static_cast<uint32_t>(snprintf(&coefficients[k], sizeof(coefficients) - k, "%s%d", (j == 0) ? "" : ",", matrix.coefficient[i][j]));
+                }
+            }
+
+            coefficients[k] = '\0';
+            doc[PixelDmxParamsConst::kMatrixPort[i].name] = coefficients;
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+            doc[PixelDmxParamsConst::kInterpolationPort[i].name] = static_cast<uint32_t>(pixel_dmx_configuration.IsPortInterpolation(i));
+#endif
+        }
+#endif
+
         doc[DmxLedParamsConst::kTestPattern.name] = std::to_underlying(PixelTestPattern::Get()->GetPattern());
     });
 }
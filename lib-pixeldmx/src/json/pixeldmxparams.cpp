@@ -24,6 +24,7 @@
  */
  
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <utility>
 
@@ -53,6 +54,10 @@ using common::store::dmxled::Flags;
 namespace json {
 PixelDmxParams::PixelDmxParams() {
     ConfigStore::Instance().Copy(&store_dmxled, &ConfigurationStore::dmx_led);
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    ConfigStore::Instance().Copy(&store_dmxled_ports, &ConfigurationStore::dmx_led_ports);
+    ConfigStore::Instance().Copy(&store_dmxled_matrix, &ConfigurationStore::dmx_led_matrix);
+#endif
 }
 
 void PixelDmxParams::SetType(const char* val, uint32_t len) {
@@ -134,6 +139,96 @@ void PixelDmxParams::SetStartUniPort(const char* key, uint32_t key_len, const ch
     store_dmxled.start_universe[index] = ParseValue<uint16_t>(val, val_len);
 }
 
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+/**
+ * The port number is the 1 or 2 digit suffix of the key
+ */
+static uint32_t GetPortIndex(const char* key, uint32_t key_len) {
+    if ((key_len >= 2) && (key[key_len - 2] >= '0') && (key[key_len - 2] <= '9')) {
+        return static_cast<uint32_t>(((key[key_len - 2] - '0') * 10) + (key[key_len - 1] - '1'));
+    }
+
+    return static_cast<uint32_t>(key[key_len - 1] - '1');
+}
+
+void PixelDmxParams::SetCountPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len) {
+    const auto kIndex = GetPortIndex(key, key_len);
+
+    if (kIndex < common::store::dmxled::kMaxUniverses) {
+        store_dmxled_ports.count[kIndex] = ParseValue<uint16_t>(val, val_len);
+    }
+}
+
+void PixelDmxParams::SetTypePort(const char* key, uint32_t key_len, const char* val, uint32_t val_len) {
+    const auto kIndex = GetPortIndex(key, key_len);
+
+    if (kIndex >= common::store::dmxled::kMaxUniverses) {
+        return;
+    }
+
+    store_dmxled_ports.type[kIndex] = 0;
+
+    if ((val_len != 0) && (val_len <= pixel::kTypesMaxNameLength)) {
+        char type[pixel::kTypesMaxNameLength + 1];
+        memcpy(type, val, val_len);
+        type[val_len] = '\0';
+
+        const auto kType = pixel::GetTypeByName(type);
+
+        if (kType != pixel::LedType::kUndefined) {
+            store_dmxled_ports.type[kIndex] = static_cast<uint8_t>(std::to_underlying(kType) + 1U);
+        }
+    }
+}
+
+void PixelDmxParams::SetMirrorPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len) {
+    const auto kIndex = GetPortIndex(key, key_len);
+
+    if (kIndex < common::store::dmxled::kMaxUniverses) {
+        store_dmxled_ports.mirror[kIndex] = ParseValue<uint8_t>(val, val_len);
+    }
+}
+
+/**
+ * The coefficients in percent, comma separated and row by row. The missing are 0, "" is no matrix.
+ */
+void PixelDmxParams::SetMatrixPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len) {
+    const auto kIndex = GetPortIndex(key, key_len);
+
+    if (kIndex >= common::store::dmxled::kMaxUniverses) {
+        return;
+    }
+
+    auto* coefficients = store_dmxled_matrix.coefficient[kIndex];
+    memset(coefficients, 0, sizeof(store_dmxled_matrix.coefficient[0]));
+
+    const auto* p = val;
+    const auto* const kEnd = val + val_len;
+
+    for (uint32_t i = 0; (i < sizeof(store_dmxled_matrix.coefficient[0])) && (p < kEnd); i++) {
+        const auto* const kStart = p;
+        while ((p < kEnd) && (*p != ',')) ++p;
+
+        coefficients[i] = static_cast<int8_t>(std::clamp(Atoi(kStart, static_cast<uint32_t>(p - kStart)), -128, 127));
+
+        if (p < kEnd) {
+            ++p; // ','
+        }
+    }
+}
+
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+void PixelDmxParams::SetInterpolationPort(const char* key, uint32_t key_len, const char* val, uint32_t val_len) {
+    const auto kIndex = GetPortIndex(key, key_len);
+
+    if ((kIndex < common::store::dmxled::kMaxUniverses) && (val_len == 1)) {
+        const auto kMask = static_cast<uint16_t>(1U << kIndex);
+        store_dmxled.interpolation = static_cast<uint16_t>((val[0] != '0') ? (store_dmxled.interpolation | kMask) : (store_dmxled.interpolation & ~kMask));
+    }
+}
+#endif
+#endif
+
 #if defined(RDM_RESPONDER)
 void PixelDmxParams::SetDmxStartAddress(const char* val, uint32_t len) {
     store_dmxled.dmx_start_address = ParseValue<uint16_t>(val, len);
@@ -143,7 +238,7 @@ void PixelDmxParams::SetDmxStartAddress(const char* val, uint32_t len) {
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
 void PixelDmxParams::SetGammaCorrection(const char* val, uint32_t len) {
     if (len == 1) {
-        store_dmxled.flags = common::SetFlagValue(store_dmxled.flags, Flags::Flag::kEnableGamma, v[0] != '0');
+        store_dmxled.flags = common::SetFlagValue(store_dmxled.flags, Flags::Flag::kEnableGamma, val[0] != '0');
     }
 }
 
@@ -162,9 +257,27 @@ void PixelDmxParams::SetGammaValue(const char* val, uint32_t len) {
 }
 #endif
 
+#if defined(OUTPUT_DMX_PIXEL_MULTI) && defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+void PixelDmxParams::SetInput16Bit(const char* val, uint32_t len) {
+    if (len == 1) {
+        store_dmxled.flags = common::SetFlagValue(store_dmxled.flags, Flags::Flag::kInput16Bit, val[0] != '0');
+    }
+}
+#endif
+
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+void PixelDmxParams::SetFrameDeadline(const char* val, uint32_t len) {
+    store_dmxled.frame_deadline_ms = ParseValue<uint8_t>(val, len);
+}
+#endif
+
 void PixelDmxParams::Store(const char* buffer, uint32_t buffer_size) {
     ParseJsonWithTable(buffer, buffer_size, kPixelDmxKeys);
     ConfigStore::Instance().Store(&store_dmxled, &ConfigurationStore::dmx_led);
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    ConfigStore::Instance().Store(&store_dmxled_ports, &ConfigurationStore::dmx_led_ports);
+    ConfigStore::Instance().Store(&store_dmxled_matrix, &ConfigurationStore::dmx_led_matrix);
+#endif
 
 #ifdef DEBUG_PIXELDMX
     Dump();
@@ -181,6 +294,15 @@ void PixelDmxParams::Set() {
     pixel_configuration.SetLowCode(store_dmxled.low_code);
     pixel_configuration.SetHighCode(store_dmxled.high_code);
     pixel_configuration.SetClockSpeedHz(store_dmxled.spi_speed_hz);
+#if defined(OUTPUT_DMX_PIXEL_MULTI)
+    for (uint32_t i = 0; i < std::min(PixelConfiguration::kMaxPorts, common::store::dmxled::kMaxUniverses); i++) {
+        const auto kType = store_dmxled_ports.type[i];
+        pixel_configuration.SetPortCount(i, store_dmxled_ports.count[i]);
+        pixel_configuration.SetPortType(i, (kType == 0) ? pixel::LedType::kUndefined : static_cast<pixel::LedType>(kType - 1U));
+        pixel_configuration.SetPortMirror(i, (store_dmxled_ports.mirror[i] == 0) ? PixelConfiguration::kMaxPorts : store_dmxled_ports.mirror[i] - 1U);
+        pixel_configuration.SetPortMatrix(i, store_dmxled_matrix.coefficient[i]);
+    }
+#endif
 #if defined(CONFIG_PIXELDMX_ENABLE_GAMMATABLE)
     pixel_configuration.SetEnableGammaCorrection(common::IsFlagSet(store_dmxled.flags, Flags::Flag::kEnableGamma));
     pixel_configuration.SetGammaTable(store_dmxled.gamma_value);
@@ -189,10 +311,19 @@ void PixelDmxParams::Set() {
     pixel_dmx_configuration.SetGroupingCount(store_dmxled.grouping_count);
 #if defined(OUTPUT_DMX_PIXEL_MULTI)
     pixel_dmx_configuration.SetOutputPorts(store_dmxled.active_outputs);
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    pixel_dmx_configuration.SetInput16Bit(common::IsFlagSet(store_dmxled.flags, Flags::Flag::kInput16Bit));
+#endif
 #endif
 #if !defined(OUTPUT_DMX_PIXEL_MULTI)
     pixel_dmx_configuration.SetDmxStartAddress(store_dmxled.dmx_start_address);
 #endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    pixel_dmx_configuration.SetFrameDeadlineMillis(store_dmxled.frame_deadline_ms);
+#endif
+#if defined(OUTPUT_DMX_PIXEL_MULTI) && defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+    pixel_dmx_configuration.SetInterpolationPorts(store_dmxled.interpolation);
+#endif
 
     DmxPixelOutputType::Get().ApplyConfiguration();
 
@@ -272,6 +403,28 @@ void PixelDmxParams::Dump() {
     }
 #if defined(OUTPUT_DMX_PIXEL_MULTI)
     printf(" %s=%d\n", DmxLedParamsConst::kActiveOutputPorts.name, store_dmxled.active_outputs);
+    for (uint32_t i = 0; i < kMaxStartUniverses; i++) {
+        const auto kType = store_dmxled_ports.type[i];
+        printf(" %s=%u\n", PixelDmxParamsConst::kCountPort[i].name, static_cast<unsigned>(store_dmxled_ports.count[i]));
+        printf(" %s=%s\n", PixelDmxParamsConst::kTypePort[i].name, (kType == 0) ? "" : pixel::GetTypeName(static_cast<pixel::LedType>(kType - 1U)));
+        printf(" %s=%u\n", PixelDmxParamsConst::kMirrorPort[i].name, static_cast<unsigned>(store_dmxled_ports.mirror[i]));
+        printf(" %s=", PixelDmxParamsConst::kMatrixPort[i].name);
+        if (pixel::ColourMatrix::IsSet(store_dmxled_matrix.coefficient[i])) {
+            for (uint32_t j = 0; j < pixel::ColourMatrix::kCoefficients; j++) {
+                printf("%s%d", (j == 0) ? "" : ",", store_dmxled_matrix.coefficient[i][j]);
+            }
+        }
+        puts("");
+#if defined(CONFIG_PIXELDMX_ENABLE_INTERPOLATION)
+        printf(" %s=%u\n", PixelDmxParamsConst::kInterpolationPort[i].name, (store_dmxled.interpolation >> i) & 1U);
+#endif
+    }
+#if defined(CONFIG_PIXELDMX_ENABLE_DITHER)
+    printf(" %s=%d\n", PixelDmxParamsConst::kInput16Bit.name, common::IsFlagSet(store_dmxled.flags, Flags::Flag::kInput16Bit));
+#endif
+#endif
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    printf(" %s=%u\n", PixelDmxParamsConst::kFrameDeadline.name, static_cast<unsigned>(store_dmxled.frame_deadline_ms));
 #endif
     printf(" %s=%u\n", DmxLedParamsConst::kTestPattern.name, static_cast<unsigned>(store_dmxled.test_pattern));
     printf(" %s=%u\n", DmxLedParamsConst::kSpiSpeedHz.name, static_cast<unsigned>(store_dmxled.spi_speed_hz));
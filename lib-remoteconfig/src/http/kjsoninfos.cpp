@@ -51,6 +51,8 @@ uint32_t RdmQueue(char*, uint32_t);
 uint32_t ShowFile(char*, uint32_t);
 uint32_t Pixel(char*, uint32_t);
 uint32_t PixelDmx(char*, uint32_t);
+uint32_t E131Sources(char*, uint32_t);
+uint32_t Ddp(char*, uint32_t);
 
 namespace emac {
 uint32_t Phy(char*, uint32_t);
@@ -65,6 +67,7 @@ uint32_t Directory(char*, uint32_t);
 namespace action {
 void Set(const char*, uint32_t);
 void SetShowFile(const char*, uint32_t);
+void SetScene(const char*, uint32_t);
 } // namespace action
 
 // Config
@@ -86,6 +89,9 @@ void SetDisplayUdf(const char*, uint32_t);
 uint32_t GetDmxNode(char*, uint32_t);
 void SetDmxNode(const char*, uint32_t);
 
+uint32_t GetDmxNodePatch(char*, uint32_t);
+void SetDmxNodePatch(const char*, uint32_t);
+
 uint32_t GetArtNet(char*, uint32_t);
 void SetArtNet(const char*, uint32_t);
 
@@ -197,6 +203,12 @@ constexpr Info kFileInfos[] = {
     ENTRY(status::Rdm, nullptr, nullptr, "status/rdm", nullptr, "Rdm"), 
 	ENTRY(status::RdmQueue, nullptr, nullptr, "status/rdm/queue", nullptr, "RdmQueue"),
 #endif
+#if defined(E131_HAVE_DISCOVERY_TABLE)
+    ENTRY(status::E131Sources, nullptr, nullptr, "status/e131/sources", nullptr, "sACN Sources"),
+#endif
+#if defined(NODE_DDP_DISPLAY)
+    ENTRY(status::Ddp, nullptr, nullptr, "status/ddp", nullptr, "DDP"),
+#endif
 #if defined(NODE_SHOWFILE)
     ENTRY(status::ShowFile, nullptr, nullptr, "status/showfile", nullptr, "Showfile"),
 #endif
@@ -205,6 +217,9 @@ constexpr Info kFileInfos[] = {
 #if defined(NODE_SHOWFILE)
     ENTRY(nullptr, action::SetShowFile, nullptr, "action/showfile", nullptr, nullptr),
 #endif
+#if defined(DMXNODE_HAVE_CROSSFADE)
+    ENTRY(nullptr, action::SetScene, nullptr, "action/scene", nullptr, nullptr),
+#endif
 #endif
     // Config
     ENTRY(config::Directory, nullptr, nullptr, "config/directory", nullptr, nullptr), 
@@ -217,6 +232,9 @@ constexpr Info kFileInfos[] = {
 // Config Node
 #if defined(DMXNODE_TYPE_ARTNET) || defined(DMXNODE_TYPE_E131)
     ENTRY(config::GetDmxNode, config::SetDmxNode, nullptr, "config/dmxnode", "DMX Node", nullptr),
+#if defined(DMXNODE_HAVE_PATCH)
+    ENTRY(config::GetDmxNodePatch, config::SetDmxNodePatch, nullptr, "config/dmxnode/patch", nullptr, nullptr),
+#endif
 #if defined(DMXNODE_TYPE_ARTNET)
     ENTRY(config::GetArtNet, config::SetArtNet, nullptr, "config/artnet", "Art-Net", nullptr),
 #endif
@@ -45,10 +45,8 @@ void ShowFileFormat::Run() {
 				ShowFileProtocol::DmxOut(universe_, dmx_data_, m_nDmxDataLength);
 			}
 		} else if (m_OlaParseCode == OlaParseCode::TIME) {
-			if (m_nDelayMillis != 0) {
-				if (m_nDmxDataLength != 0) {
-					ShowFileProtocol::DmxSync();
-				}
+			if (m_nDmxDataLength != 0) {
+				ShowFileProtocol::DmxSync();
 			}
 			m_OlaState = OlaState::TIME_WAITING;
 		} else if (m_OlaParseCode == OlaParseCode::EOFILE) {
@@ -30,6 +30,7 @@
 
 #include "tlc59711.h"
 #include "dmxnode.h"
+#include "dmxnodedata.h"
 
 class TLC59711Dmx {
    public:
@@ -41,6 +42,19 @@ class TLC59711Dmx {
 
     template <bool doUpdate> void SetData(uint32_t port_index, const uint8_t* data, uint32_t length);
 
+#if defined(DMXNODE_HAVE_DIRTY_SLOTS)
+    static constexpr bool kHasDirtySlots = true;
+
+    /**
+     * The chain is only shifted out when a slot within the footprint changed
+     */
+    template <bool doUpdate> void SetData(uint32_t port_index, const uint8_t* data, uint32_t length, const dmxnode::DirtySlots& dirty) {
+        if (dirty.IsDirty(dmx_start_address_ - 1U, dmx_footprint_)) {
+            SetData<doUpdate>(port_index, data, length);
+        }
+    }
+#endif
+
     void Sync(uint32_t port_index);
     void Sync();
 
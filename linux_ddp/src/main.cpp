@@ -97,6 +97,7 @@ int main(int argc, char** argv) // NOLINT
 
     while (keep_running) {
         network::Run();
+        ddp_display.Run();
         board::Run();
     }
 
@@ -0,0 +1,10 @@
+#!/bin/bash
+
+make
+retVal=$?
+if [ $retVal -ne 0 ]; then
+	echo "Error"
+	exit $retVal
+fi
+
+sudo ./linux_e131_pixel bond0 /dev/spidev0.0
@@ -0,0 +1,102 @@
+/**
+ * @file main.cpp
+ *
+ */
+/* Copyright (C) 2025 by Arjan van Vught mailto:info@gd32-dmx.org
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <signal.h>
+
+#include "board.h"
+#include "network.h"
+#include "displayudf.h"
+#include "json/displayudfparams.h"
+#include "json/dmxnodenode.h"
+#include "dmxnodemsgconst.h"
+#include "json/pixeldmxparams.h"
+#include "pixeldmx.h"
+#include "spi.h"
+#include "configstore.h"
+#include "remoteconfig.h"
+#include "firmware/firmwareversion.h"
+#include "software_version.h"
+
+static bool keep_running = true;
+
+void IntHandler(int) {
+    keep_running = false;
+}
+
+int main(int argc, char** argv) { // NOLINT
+    struct sigaction act;
+    act.sa_handler = IntHandler;
+    sigaction(SIGINT, &act, nullptr);
+    board::Init();
+    DisplayUdf display;
+    ConfigStore config_store;
+    Network nw(argc, argv);
+    FirmwareVersion fw(kSoftwareVersion, __DATE__, __TIME__);
+
+    board::Print();
+    fw.Print("sACN Pixel controller {1x 4 Universes}");
+    nw.Print();
+
+    // The spidev of the pixel output, a regular file or a FIFO receives the frames as is
+    if (argc > 2) {
+        spi::SetDevice(argv[2]);
+    }
+
+    DmxNodeNode dmx_node_node;
+
+    PixelDmx pixeldmx;
+
+    json::PixelDmxParams pixeldmx_params;
+    pixeldmx_params.Load();
+    pixeldmx_params.Set();
+
+    dmx_node_node.SetOutput(&pixeldmx);
+    dmx_node_node.Print();
+    pixeldmx.Print();
+
+    display.SetTitle("sACN Pixel 1x4U");
+    display.Set(2, displayudf::Labels::kIp);
+    display.Set(3, displayudf::Labels::kVersion);
+    display.Set(4, displayudf::Labels::kHostname);
+
+    json::DisplayUdfParams displayudf_params;
+    displayudf_params.Load();
+    displayudf_params.SetAndShow();
+
+    RemoteConfig remote_config(remoteconfig::Output::PIXEL, dmx_node_node.GetActiveOutputPorts());
+
+    dmx_node_node.Start();
+
+    while (keep_running) {
+        network::Run();
+        dmx_node_node.Run();
+        pixeldmx.Run();
+        board::Run();
+    }
+
+    pixeldmx.Blackout();
+
+    return 0;
+}
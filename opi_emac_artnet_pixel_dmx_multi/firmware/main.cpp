@@ -147,6 +147,7 @@ int main() // NOLINT
 #if defined(NODE_SHOWFILE)
         showfile.Run();
 #endif
+        pixeldmx_multi.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
@@ -123,6 +123,7 @@ int main() // NOLINT
 #if defined(NODE_SHOWFILE)
         showfile.Run();
 #endif
+        pixeldmx_multi.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
@@ -98,6 +98,10 @@ int main() { // NOLINT
     dmxNode.Print();
 
     ddp_display.SetOutput(&dmxNode);
+    ddp_display.SetPixelOutput((PixelTestPattern::Get()->GetPattern() != pixelpatterns::Pattern::kNone) ? nullptr : &pixeldmx_multi);
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    ddp_display.SetFrameDeadlineMillis(pixeldmx_multi.GetFrameDeadlineMillis());
+#endif
     ddp_display.Print();
 
 #if defined(NODE_RDMNET_LLRP_ONLY)
@@ -130,6 +134,8 @@ int main() { // NOLINT
     for (;;) {
         watchdog::Feed();
         network::Run();
+        pixeldmx_multi.Run();
+        ddp_display.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
@@ -84,6 +84,10 @@ int main() { // NOLINT
     const auto kTestPattern = pixeltest_pattern.GetPattern();
 
     ddpdisplay.SetOutput(&pixeldmx_multi);
+    ddpdisplay.SetPixelOutput(&pixeldmx_multi);
+#if defined(CONFIG_PIXELDMX_ENABLE_GOVERNOR)
+    ddpdisplay.SetFrameDeadlineMillis(pixeldmx_multi.GetFrameDeadlineMillis());
+#endif
     ddpdisplay.Print();
 
 #if defined(NODE_RDMNET_LLRP_ONLY)
@@ -117,6 +121,8 @@ int main() { // NOLINT
     for (;;) {
         watchdog::Feed();
         network::Run();
+        pixeldmx_multi.Run();
+        ddpdisplay.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
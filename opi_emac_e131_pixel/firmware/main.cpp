@@ -117,6 +117,7 @@ int main() // NOLINT
 #if defined(NODE_SHOWFILE)
         showfile.Run();
 #endif
+        pixeldmx.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
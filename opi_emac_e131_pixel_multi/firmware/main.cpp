@@ -122,6 +122,7 @@ int main() // NOLINT
 #if defined(NODE_SHOWFILE)
         showfile.Run();
 #endif
+        pixeldmx_multi.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
@@ -108,6 +108,7 @@ int main() { // NOLINT
     for (;;) {
         watchdog::Feed();
         network::Run();
+        pixeldmx.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
@@ -124,6 +124,7 @@ int main() { // NOLINT
         watchdog::Feed();
         network::Run();
         pp.Run();
+        pixeldmx_multi.Run();
         pixeltest_pattern.Run();
         display.Run();
         board::Run();
@@ -141,6 +141,7 @@ int main() { // NOLINT
 #if !defined(NO_EMAC)
         network::Run();
 #endif
+        pixeldmx.Run();
         pixel_test_pattern.Run();
         display.Run();
         board::Run();